@@ -0,0 +1,143 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "correlated_measurement.h"
+#include "measurement.h"
+#include <mp-units/bits/hacks.h>
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#include <mp-units/math.h>
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+#endif
+
+
+static_assert(mp_units::RepresentationOf<correlated_measurement<double>, mp_units::quantity_tensor_order::scalar>);
+static_assert(mp_units::RepresentationOf<correlated_measurement<double>, mp_units::quantity_tensor_order::vector>);
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+void correlations()
+{
+  uncertainty_tape<double> tape;
+
+  const auto length = tape.input(123., 1.) * m;
+  const auto independent = measurement{123., 1.} * m;
+  std::cout << "Self-difference:        d - d = " << length - length << " (independent model: "
+            << independent - independent << ")\n";
+  std::cout << "Self-ratio:             d / d = " << length / length << " (independent model: "
+            << independent / independent << ")\n";
+
+  // two results derived from the same inputs are correlated
+  const auto acceleration = isq::acceleration(tape.input(9.8, 0.1) * m / s2);
+  const auto time = tape.input(1.2, 0.1) * s;
+  const QuantityOf<isq::velocity> auto velocity = acceleration * time;
+  const QuantityOf<isq::length> auto distance = acceleration * pow<2>(time) / 2;
+  std::cout << "Velocity:               V = " << velocity << '\n';
+  std::cout << "Distance:               s = " << distance << '\n';
+  std::cout << "Correlation:            ρ(V, s) = "
+            << correlation(velocity.numerical_value_in(m / s), distance.numerical_value_in(m)) << '\n';
+}
+
+// Builds an expression graph of `nodes` arithmetic operations on quantities with the representation
+// type `Rep` (4 operations per iteration)
+template<typename Rep>
+quantity<si::metre, Rep> graph(std::size_t nodes, const quantity<si::metre, Rep>& a,
+                               const quantity<si::second, Rep>& b, const quantity<si::second, Rep>& c)
+{
+  quantity<si::metre, Rep> acc = a;
+  for (std::size_t i = 0; i < nodes / 4; ++i) acc = acc * 0.5 + a * b / c;
+  return acc;
+}
+
+template<typename F>
+double ns_per_node(std::size_t nodes, std::size_t batches, F&& batch)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < batches; ++i) batch();
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(nodes * batches);
+}
+
+void benchmark()
+{
+  constexpr std::size_t nodes = 1'000'000;
+  constexpr std::size_t batches = 10;
+
+  quantity<si::metre> plain_result{};
+  const double plain =
+    ns_per_node(nodes, batches, [&] { plain_result = graph<double>(nodes, 2. * m, 3. * s, 4. * s); });
+
+  quantity<si::metre, measurement<double>> independent_result{};
+  const double independent = ns_per_node(nodes, batches, [&] {
+    independent_result = graph<measurement<double>>(nodes, measurement{2., 0.1} * m, measurement{3., 0.1} * s,
+                                                    measurement{4., 0.1} * s);
+  });
+
+  // one tape for all the batches: after the first one the arena does not allocate any more
+  uncertainty_tape<double> tape;
+  double correlated_value{};
+  double correlated_uncertainty{};
+  const double correlated = ns_per_node(nodes, batches, [&] {
+    tape.reset();
+    const auto res = graph<correlated_measurement<double>>(nodes, tape.input(2., 0.1) * m, tape.input(3., 0.1) * s,
+                                                           tape.input(4., 0.1) * s);
+    correlated_value = res.numerical_value_in(m).value();
+    correlated_uncertainty = res.numerical_value_in(m).uncertainty();
+  });
+
+  std::cout << "\nExpression graph of " << nodes << " nodes (" << batches << " batches):\n";
+  std::cout << "  double:                         " << plain << " ns/node, result = " << plain_result << '\n';
+  std::cout << "  measurement<double>:            " << independent << " ns/node, result = " << independent_result
+            << '\n';
+  std::cout << "  correlated_measurement<double>: " << correlated << " ns/node, result = " << correlated_value
+            << " ± " << correlated_uncertainty << " m\n";
+  std::cout << "  arena capacity:                 " << tape.arena().capacity() / 1024 << " KiB\n";
+}
+
+}  // namespace
+
+int main()
+{
+  try {
+    correlations();
+    benchmark();
+  } catch (const std::exception& ex) {
+    std::cerr << "Unhandled std exception caught: " << ex.what() << '\n';
+  } catch (...) {
+    std::cerr << "Unhandled unknown exception caught\n";
+  }
+}
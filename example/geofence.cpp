@@ -0,0 +1,137 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "geographic.h"
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/format.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+// Computes the distances from one point to a million waypoints, first one pair at a time and then with the
+// batch `spherical_distance()` overloads, and counts the waypoints inside a geofence.
+
+namespace {
+
+using namespace geographic;
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+// waypoints scattered up to ~200 km around the center
+std::vector<position<double>> get_waypoints(position<double> center, std::size_t count)
+{
+  std::mt19937 gen(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::uniform_real_distribution<double> dlat(-1.8, 1.8);
+  std::uniform_real_distribution<double> dlon(-3.0, 3.0);
+  std::vector<position<double>> res;
+  res.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) res.emplace_back(center.lat + dlat(gen) * deg, center.lon + dlon(gen) * deg);
+  return res;
+}
+
+template<typename F>
+double distances_per_second(std::size_t count, F&& f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(count) / elapsed.count();
+}
+
+double max_relative_error(const std::vector<distance>& approx, const std::vector<distance>& exact)
+{
+  double res = 0;
+  for (std::size_t i = 0; i < exact.size(); ++i)
+    if (exact[i] > 1 * km) res = std::max(res, (abs(approx[i] - exact[i]) / exact[i]).numerical_value_in(one));
+  return res;
+}
+
+void example()
+{
+  using namespace geographic::literals;
+
+  const position<double> center{54.35205_N, 18.64637_E};  // Gdańsk
+  const quantity fence_radius = 50. * isq::distance[km];
+  constexpr std::size_t count = 1'000'000;
+
+  const std::vector<position<double>> waypoints = get_waypoints(center, count);
+  const position_array<double> soa(waypoints);
+  std::vector<distance> scalar(count);
+  std::vector<distance> exact(count);
+  std::vector<distance> out(count);
+
+  std::cout << MP_UNITS_STD_FMT::format("Distances from Gdańsk to {} waypoints:\n\n", count);
+  std::cout << MP_UNITS_STD_FMT::format("| {:<28} | {:>14} | {:>14} | {:>8} |\n", "Method", "distances/s",
+                                        "max rel error", "inside");
+  std::cout << MP_UNITS_STD_FMT::format("|{0:-^30}|{0:-^16}|{0:-^16}|{0:-^10}|\n", "");
+
+  spherical_distance(center, soa, exact, great_circle_formula::vincenty);
+  const auto report = [&](std::string_view name, double rate, const std::vector<distance>& res) {
+    const auto inside = std::ranges::count_if(res, [&](const distance& d) { return d <= fence_radius; });
+    std::cout << MP_UNITS_STD_FMT::format("| {:<28} | {:>14.0f} | {:>14.2e} | {:>8} |\n", name, rate,
+                                          max_relative_error(res, exact), inside);
+  };
+
+  const double scalar_rate = distances_per_second(count, [&] {
+    for (std::size_t i = 0; i < count; ++i) scalar[i] = spherical_distance(center, waypoints[i]);
+  });
+  report("one pair at a time", scalar_rate, scalar);
+
+  const double aos_rate = distances_per_second(count, [&] {
+    spherical_distance(center, std::span<const position<double>>(waypoints), out);
+  });
+  report("batch (array of structures)", aos_rate, out);
+
+  for (const auto& [name, formula] : {std::pair{"batch haversine", great_circle_formula::haversine},
+                                     std::pair{"batch vincenty", great_circle_formula::vincenty},
+                                     std::pair{"batch equirectangular", great_circle_formula::equirectangular}}) {
+    const double rate = distances_per_second(count, [&] { spherical_distance(center, soa, out, formula); });
+    report(name, rate, out);
+  }
+}
+
+}  // namespace
+
+int main()
+{
+  try {
+    example();
+  } catch (const std::exception& ex) {
+    std::cerr << "Unhandled std exception caught: " << ex.what() << '\n';
+  } catch (...) {
+    std::cerr << "Unhandled unknown exception caught\n";
+  }
+}
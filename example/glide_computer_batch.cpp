@@ -0,0 +1,165 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "geographic.h"
+#include "glide_computer_lib.h"
+#include <mp-units/bits/hacks.h>
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/format.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+// Evaluates thousands of candidate tasks for several gliders under several weather conditions, first one
+// scenario at a time and then with the parallel `simulate_all()`.
+
+namespace {
+
+using namespace geographic;
+using namespace glide_computer;
+using namespace mp_units;
+
+std::vector<glider> get_gliders()
+{
+  using namespace mp_units::si::unit_symbols;
+  MP_UNITS_DIAGNOSTIC_PUSH
+  MP_UNITS_DIAGNOSTIC_IGNORE_MISSING_BRACES
+  return {glider{"SZD-30 Pirat", {83 * km / h, -0.7389 * m / s}},
+          glider{"SZD-51 Junior", {80 * km / h, -0.6349 * m / s}},
+          glider{"SZD-48 Jantar Std 3", {110 * km / h, -0.77355 * m / s}},
+          glider{"SZD-56 Diana", {110 * km / h, -0.63657 * m / s}}};
+  MP_UNITS_DIAGNOSTIC_POP
+}
+
+std::vector<weather> get_weather_conditions()
+{
+  using namespace mp_units::si::unit_symbols;
+  return {weather{1900 * m, 4.3 * m / s}, weather{1550 * m, 2.8 * m / s}, weather{850 * m, 1.8 * m / s}};
+}
+
+// triangles starting and finishing at the home airfield with two random turn points
+std::vector<task> get_tasks(std::size_t count)
+{
+  using namespace geographic::literals;
+  using namespace mp_units::si::unit_symbols;
+
+  std::mt19937 gen(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::uniform_real_distribution<double> lat(53.0, 55.0);
+  std::uniform_real_distribution<double> lon(17.0, 20.0);
+  std::uniform_real_distribution<double> alt(0., 200.);
+  const auto turn_point = [&](std::string name) {
+    return waypoint{std::move(name), {equator + lat(gen) * deg, prime_meridian + lon(gen) * deg},
+                    mean_sea_level + alt(gen) * m};
+  };
+
+  const waypoint home{"EPPR", {54.24772_N, 18.6745_E}, mean_sea_level + 5. * m};
+  std::vector<task> res;
+  res.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) res.push_back({home, turn_point("TP1"), turn_point("TP2"), home});
+  return res;
+}
+
+void example()
+{
+  using namespace mp_units::si::unit_symbols;
+
+  const safety sfty = {300 * m};
+  const aircraft_tow tow = {400 * m, 1.6 * m / s};
+  const timestamp start_time(std::chrono::system_clock::now());
+  const auto gliders = get_gliders();
+  const auto conditions = get_weather_conditions();
+  const auto tasks = get_tasks(10000);
+  const std::size_t scenarios = gliders.size() * conditions.size() * tasks.size();
+
+  const auto scenarios_per_second = [&](std::chrono::steady_clock::duration d) {
+    return static_cast<double>(scenarios) / std::chrono::duration<double>(d).count();
+  };
+
+  // one scenario at a time
+  auto start = std::chrono::steady_clock::now();
+  std::vector<flight_estimate> sequential;
+  sequential.reserve(scenarios);
+  for (const auto& g : gliders)
+    for (const auto& w : conditions)
+      for (const auto& t : tasks) sequential.push_back(simulate(start_time, g, w, t, sfty, tow));
+  const auto sequential_time = std::chrono::steady_clock::now() - start;
+
+  // all the scenarios in parallel
+  start = std::chrono::steady_clock::now();
+  const std::vector<flight_estimate> parallel = simulate_all(start_time, gliders, conditions, tasks, sfty, tow);
+  const auto parallel_time = std::chrono::steady_clock::now() - start;
+
+  const bool same = std::ranges::equal(sequential, parallel, [](const flight_estimate& a, const flight_estimate& b) {
+    return a.time == b.time && a.profile.size() == b.profile.size();
+  });
+
+  std::cout << MP_UNITS_STD_FMT::format("Scenarios:  {} ({} gliders x {} weather conditions x {} tasks)\n", scenarios,
+                                        gliders.size(), conditions.size(), tasks.size());
+  std::cout << MP_UNITS_STD_FMT::format("Sequential: {:.0f} scenarios/s\n", scenarios_per_second(sequential_time));
+  std::cout << MP_UNITS_STD_FMT::format("Parallel:   {:.0f} scenarios/s (x{:.1f}, results {})\n\n",
+                                        scenarios_per_second(parallel_time),
+                                        std::chrono::duration<double>(sequential_time) / parallel_time,
+                                        same ? "identical" : "DIFFERENT");
+
+  // the fastest task for every glider in the best weather
+  for (std::size_t i = 0; i < gliders.size(); ++i) {
+    const auto first = parallel.begin() + static_cast<std::ptrdiff_t>(i * conditions.size() * tasks.size());
+    // a task that cannot be flown has no meaningful time, so it must never win
+    const auto best =
+      std::ranges::min_element(first, first + static_cast<std::ptrdiff_t>(tasks.size()), {},
+                               [](const flight_estimate& e) { return e.completed ? e.time : duration::max(); });
+    if (!best->completed) {
+      std::cout << MP_UNITS_STD_FMT::format("{:<20} cannot complete any task\n", gliders[i].name);
+      continue;
+    }
+    std::cout << MP_UNITS_STD_FMT::format("{:<20} fastest task: {::N[.1f]} in {::N[.1f]} ({} flight phases)\n",
+                                          gliders[i].name, best->dist, best->time.in(min), best->profile.size());
+  }
+}
+
+}  // namespace
+
+int main()
+{
+  try {
+    example();
+  } catch (const std::exception& ex) {
+    std::cerr << "Unhandled std exception caught: " << ex.what() << '\n';
+  } catch (...) {
+    std::cerr << "Unhandled unknown exception caught\n";
+  }
+}
@@ -25,6 +25,9 @@
 #ifdef MP_UNITS_IMPORT_STD
 import std;
 #else
+#include <algorithm>
+#include <cstddef>
+#include <execution>
 #include <functional>
 #include <iostream>
 #include <numeric>
@@ -84,43 +87,28 @@ namespace {
 
 using namespace glide_computer;
 
-void print(std::string_view phase_name, timestamp start_ts, const glide_computer::flight_point& point,
-           const glide_computer::flight_point& new_point)
-{
-  std::cout << MP_UNITS_STD_FMT::format(
-    "| {:<12} | {:>9:N[.1f]} (Total: {:>9:N[.1f]}) | {:>8:N[.1f]} (Total: {:>8:N[.1f]}) | {:>7:N[.0f]} ({:>6:N[.0f]}) "
-    "|\n",
-    phase_name, value_cast<si::minute>(new_point.ts - point.ts), value_cast<si::minute>(new_point.ts - start_ts),
-    new_point.dist - point.dist, new_point.dist, new_point.alt - point.alt, new_point.alt);
-}
+// The flight phases are pure functions of the current position, so that the same model serves both the
+// printed estimate of a single scenario and the parallel batch evaluation.
 
 flight_point takeoff(timestamp start_ts, const task& t) { return {start_ts, t.get_start().alt}; }
 
-flight_point tow(timestamp start_ts, const flight_point& pos, const aircraft_tow& at)
+flight_point tow(const flight_point& pos, const aircraft_tow& at)
 {
   const duration d = (at.height_agl / at.performance);
-  const flight_point new_pos{pos.ts + d, pos.alt + at.height_agl, pos.leg_idx, pos.dist};
-
-  print("Tow", start_ts, pos, new_pos);
-  return new_pos;
+  return {pos.ts + d, pos.alt + at.height_agl, pos.leg_idx, pos.dist};
 }
 
-flight_point circle(timestamp start_ts, const flight_point& pos, const glider& g, const weather& w, const task& t,
-                    height& height_to_gain)
+flight_point circle(const flight_point& pos, const glider& g, const weather& w, const task& t, height& height_to_gain)
 {
   const height h_agl = agl(pos.alt, terrain_level_alt(t, pos));
   const height circling_height = std::min(w.cloud_base - h_agl, height_to_gain);
   const rate_of_climb circling_rate = w.thermal_strength + g.polar[0].climb;
   const duration d = (circling_height / circling_rate);
-  const flight_point new_pos{pos.ts + d, pos.alt + circling_height, pos.leg_idx, pos.dist};
-
   height_to_gain -= circling_height;
-
-  print("Circle", start_ts, pos, new_pos);
-  return new_pos;
+  return {pos.ts + d, pos.alt + circling_height, pos.leg_idx, pos.dist};
 }
 
-flight_point glide(timestamp start_ts, const flight_point& pos, const glider& g, const task& t, const safety& s)
+flight_point glide(const flight_point& pos, const glider& g, const task& t, const safety& s)
 {
   const auto ground_alt = terrain_level_alt(t, pos);
   const auto dist = glide_distance(pos, g, t, s, ground_alt);
@@ -128,40 +116,65 @@ flight_point glide(timestamp start_ts, const flight_point& pos, const glider& g,
   const auto alt = ground_alt + s.min_agl_height;
   const auto l3d = length_3d(dist, pos.alt - alt);
   const duration d = l3d / g.polar[0].v;
-  const flight_point new_pos{pos.ts + d, terrain_level_alt(t, pos) + s.min_agl_height, t.get_leg_index(new_distance),
-                             new_distance};
-
-  print("Glide", start_ts, pos, new_pos);
-  return new_pos;
+  return {pos.ts + d, terrain_level_alt(t, pos) + s.min_agl_height, t.get_leg_index(new_distance), new_distance};
 }
 
-flight_point final_glide(timestamp start_ts, const flight_point& pos, const glider& g, const task& t)
+flight_point final_glide(const flight_point& pos, const glider& g, const task& t)
 {
   const auto dist = t.get_distance() - pos.dist;
   const auto l3d = length_3d(dist, pos.alt - t.get_finish().alt);
   const duration d = l3d / g.polar[0].v;
-  const flight_point new_pos{pos.ts + d, t.get_finish().alt, t.get_legs().size() - 1, pos.dist + dist};
+  return {pos.ts + d, t.get_finish().alt, t.get_legs().size() - 1, pos.dist + dist};
+}
 
-  print("Final Glide", start_ts, pos, new_pos);
-  return new_pos;
+std::string_view to_string(flight_phase phase)
+{
+  switch (phase) {
+    case flight_phase::takeoff:
+      return "Takeoff";
+    case flight_phase::tow:
+      return "Tow";
+    case flight_phase::glide:
+      return "Glide";
+    case flight_phase::circle:
+      return "Circle";
+    case flight_phase::final_glide:
+      return "Final Glide";
+  }
+  return "";
+}
+
+void print(timestamp start_ts, const profile_point& point, const profile_point& new_point)
+{
+  const flight_point& p = point.point;
+  const flight_point& np = new_point.point;
+  std::cout << MP_UNITS_STD_FMT::format(
+    "| {:<12} | {:>9:N[.1f]} (Total: {:>9:N[.1f]}) | {:>8:N[.1f]} (Total: {:>8:N[.1f]}) | {:>7:N[.0f]} ({:>6:N[.0f]}) "
+    "|\n",
+    to_string(new_point.phase), value_cast<si::minute>(np.ts - p.ts), value_cast<si::minute>(np.ts - start_ts),
+    np.dist - p.dist, np.dist, np.alt - p.alt, np.alt);
 }
 
 }  // namespace
 
 namespace glide_computer {
 
-void estimate(timestamp start_ts, const glider& g, const weather& w, const task& t, const safety& s,
-              const aircraft_tow& at)
+flight_estimate simulate(timestamp start_ts, const glider& g, const weather& w, const task& t, const safety& s,
+                         const aircraft_tow& at)
 {
-  std::cout << MP_UNITS_STD_FMT::format("| {:<12} | {:^28} | {:^26} | {:^21} |\n", "Flight phase", "Duration",
-                                        "Distance", "Height");
-  std::cout << MP_UNITS_STD_FMT::format("|{0:-^14}|{0:-^30}|{0:-^28}|{0:-^23}|\n", "");
+  flight_estimate res;
+  res.profile.reserve(8);
 
   // ready to takeoff
   flight_point pos = takeoff(start_ts, t);
+  res.profile.push_back({flight_phase::takeoff, pos});
 
   // estimate aircraft towing
-  pos = tow(start_ts, pos, at);
+  pos = tow(pos, at);
+  res.profile.push_back({flight_phase::tow, pos});
+
+  // the glider sinks faster than it can climb in the thermals
+  if (w.thermal_strength + g.polar[0].climb <= rate_of_climb::zero()) return res;
 
   // estimate the msl_altitude needed to reach the finish line from this place
   const geographic::msl_altitude final_glide_alt =
@@ -172,14 +185,50 @@ void estimate(timestamp start_ts, const glider& g, const weather& w, const task&
 
   do {
     // glide to the next thermall
-    pos = glide(start_ts, pos, g, t, s);
+    pos = glide(pos, g, t, s);
+    res.profile.push_back({flight_phase::glide, pos});
 
     // circle in a thermall to gain height
-    pos = circle(start_ts, pos, g, w, t, height_to_gain);
+    pos = circle(pos, g, w, t, height_to_gain);
+    res.profile.push_back({flight_phase::circle, pos});
   } while (height_to_gain > height{});
 
   // final glide
-  pos = final_glide(start_ts, pos, g, t);
+  pos = final_glide(pos, g, t);
+  res.profile.push_back({flight_phase::final_glide, pos});
+
+  res.time = pos.ts - start_ts;
+  res.dist = pos.dist;
+  res.completed = true;
+  return res;
+}
+
+std::vector<flight_estimate> simulate_all(timestamp start_ts, std::span<const glider> gliders,
+                                          std::span<const weather> conditions, std::span<const task> tasks,
+                                          const safety& s, const aircraft_tow& at)
+{
+  std::vector<flight_estimate> res(gliders.size() * conditions.size() * tasks.size());
+  // `par` rather than `par_unseq`: every simulation allocates its flight profile, which is not allowed in
+  // an unsequenced context
+  std::for_each(std::execution::par, res.begin(), res.end(), [&](flight_estimate& e) {
+    const auto idx = static_cast<std::size_t>(&e - res.data());
+    const std::size_t k = idx % tasks.size();
+    const std::size_t j = idx / tasks.size() % conditions.size();
+    const std::size_t i = idx / tasks.size() / conditions.size();
+    e = simulate(start_ts, gliders[i], conditions[j], tasks[k], s, at);
+  });
+  return res;
+}
+
+void estimate(timestamp start_ts, const glider& g, const weather& w, const task& t, const safety& s,
+              const aircraft_tow& at)
+{
+  std::cout << MP_UNITS_STD_FMT::format("| {:<12} | {:^28} | {:^26} | {:^21} |\n", "Flight phase", "Duration",
+                                        "Distance", "Height");
+  std::cout << MP_UNITS_STD_FMT::format("|{0:-^14}|{0:-^30}|{0:-^28}|{0:-^23}|\n", "");
+
+  const flight_estimate res = simulate(start_ts, g, w, t, s, at);
+  for (std::size_t i = 1; i < res.profile.size(); ++i) print(start_ts, res.profile[i - 1], res.profile[i]);
 }
 
 }  // namespace glide_computer
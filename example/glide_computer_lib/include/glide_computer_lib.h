@@ -33,9 +33,11 @@ import std;
 #include <chrono>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
 #include <ranges>
+#include <span>
 #include <string>  // IWYU pragma: keep
 #include <vector>
 #endif
@@ -146,8 +148,10 @@ public:
   }
   [[nodiscard]] std::size_t get_leg_index(distance dist) const
   {
-    return static_cast<std::size_t>(
+    // a glide may end beyond the finish line
+    const auto idx = static_cast<std::size_t>(
       std::ranges::distance(leg_total_distances_.cbegin(), std::ranges::lower_bound(leg_total_distances_, dist)));
+    return std::min(idx, legs_.size() - 1);
   }
 
 private:
@@ -192,6 +196,30 @@ inline mp_units::quantity<mp_units::isq::length[mp_units::si::kilo<mp_units::si:
 distance glide_distance(const flight_point& pos, const glider& g, const task& t, const safety& s,
                         geographic::msl_altitude ground_alt);
 
+enum class flight_phase : std::uint8_t { takeoff, tow, glide, circle, final_glide };
+
+struct profile_point {
+  flight_phase phase;
+  flight_point point;
+};
+
+struct flight_estimate {
+  duration time{};                     // from the takeoff to the finish line
+  distance dist{};                     // the distance flown along the task
+  std::vector<profile_point> profile;  // the position at the end of each flight phase
+  bool completed = false;              // `false` if the thermals are too weak to climb at all
+};
+
+flight_estimate simulate(timestamp start_ts, const glider& g, const weather& w, const task& t, const safety& s,
+                         const aircraft_tow& at);
+
+// Simulates every glider × weather × task combination in parallel. The estimate for
+// `gliders[i]`, `conditions[j]`, and `tasks[k]` is stored at the index
+// `(i * conditions.size() + j) * tasks.size() + k` of the result.
+std::vector<flight_estimate> simulate_all(timestamp start_ts, std::span<const glider> gliders,
+                                          std::span<const weather> conditions, std::span<const task> tasks,
+                                          const safety& s, const aircraft_tow& at);
+
 void estimate(timestamp start_ts, const glider& g, const weather& w, const task& t, const safety& s,
               const aircraft_tow& at);
 
@@ -0,0 +1,421 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <cmath>
+#include <compare>  // IWYU pragma: export
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+
+/**
+ * @brief A bump (arena) allocator for trivially destructible objects.
+ *
+ * Memory is handed out sequentially from large blocks and is never freed individually.
+ * `reset()` makes all the blocks available again at once, so a workload that is processed in
+ * batches reaches a steady state with no heap allocations at all.
+ */
+class monotonic_arena {
+public:
+  explicit monotonic_arena(std::size_t block_size = std::size_t{1} << 20) : block_size_(block_size) {}
+
+  monotonic_arena(const monotonic_arena&) = delete;
+  monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+  /// @brief Allocates uninitialized storage for `n` objects of type `T`
+  template<typename T>
+    requires std::is_trivially_destructible_v<T>
+  [[nodiscard]] T* allocate(std::size_t n)
+  {
+    const std::size_t bytes = n * sizeof(T);
+    for (; current_ < blocks_.size(); ++current_, offset_ = 0) {
+      const block& b = blocks_[current_];
+      const std::size_t offset = (offset_ + alignof(T) - 1) / alignof(T) * alignof(T);
+      if (offset + bytes <= b.size) {
+        offset_ = offset + bytes;
+        return std::launder(reinterpret_cast<T*>(b.data.get() + offset));
+      }
+    }
+    const std::size_t size = std::max(block_size_, bytes);
+    blocks_.push_back(block{std::make_unique_for_overwrite<std::byte[]>(size), size});
+    offset_ = bytes;
+    return std::launder(reinterpret_cast<T*>(blocks_.back().data.get()));
+  }
+
+  /// @brief Returns the unused tail of the most recent allocation (`p` must point to it)
+  template<typename T>
+  void shrink_last(const T* p, std::size_t allocated, std::size_t used) noexcept
+  {
+    const auto* const end = reinterpret_cast<const std::byte*>(p + allocated);
+    if (current_ < blocks_.size() && end == blocks_[current_].data.get() + offset_)
+      offset_ -= (allocated - used) * sizeof(T);
+  }
+
+  /// @brief Releases all the allocations at once (keeps the memory blocks for reuse)
+  void reset() noexcept
+  {
+    current_ = 0;
+    offset_ = 0;
+  }
+
+  /// @brief The number of bytes reserved from the heap
+  [[nodiscard]] std::size_t capacity() const noexcept
+  {
+    std::size_t res = 0;
+    for (const block& b : blocks_) res += b.size;
+    return res;
+  }
+
+private:
+  struct block {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t size;
+  };
+  std::vector<block> blocks_;
+  std::size_t current_ = 0;
+  std::size_t offset_ = 0;
+  std::size_t block_size_;
+};
+
+template<typename T>
+class correlated_measurement;
+
+/**
+ * @brief The independent inputs of a computation and the storage of its sensitivities.
+ *
+ * Every `correlated_measurement` created with `input()` is a new independent variable with
+ * its own standard deviation. Derived measurements keep the sensitivities (first-order partial
+ * derivatives) of their value with respect to those inputs in the arena of the tape.
+ *
+ * @warning `reset()` invalidates all the measurements created with this tape. The tape is not
+ *          thread-safe; use one tape per thread.
+ */
+template<typename T>
+class uncertainty_tape {
+public:
+  struct term {
+    std::uint32_t input;
+    T sensitivity;
+  };
+
+  explicit uncertainty_tape(std::size_t arena_block_size = std::size_t{1} << 20) : arena_(arena_block_size) {}
+
+  uncertainty_tape(const uncertainty_tape&) = delete;
+  uncertainty_tape& operator=(const uncertainty_tape&) = delete;
+
+  /// @brief Registers a new independent input with the given standard deviation
+  [[nodiscard]] correlated_measurement<T> input(T value, T uncertainty)
+  {
+    using std::abs;
+    const auto id = static_cast<std::uint32_t>(uncertainties_.size());
+    uncertainties_.push_back(abs(uncertainty));
+    term* const t = arena_.allocate<term>(1);
+    *t = term{id, T{1}};
+    return correlated_measurement<T>(std::move(value), *this, t, 1);
+  }
+
+  /// @brief The standard deviation of the input `id`
+  [[nodiscard]] const T& input_uncertainty(std::uint32_t id) const { return uncertainties_[id]; }
+
+  [[nodiscard]] std::size_t inputs() const noexcept { return uncertainties_.size(); }
+  [[nodiscard]] const monotonic_arena& arena() const noexcept { return arena_; }
+
+  /// @brief Starts a new batch: forgets all the inputs and releases the sensitivities at once
+  void reset() noexcept
+  {
+    uncertainties_.clear();
+    arena_.reset();
+  }
+
+private:
+  friend class correlated_measurement<T>;
+  monotonic_arena arena_;
+  std::vector<T> uncertainties_;
+};
+
+/**
+ * @brief A representation type for measurements with correlation-aware uncertainty propagation.
+ *
+ * Unlike `measurement<T>`, which only combines standard deviations and therefore assumes that
+ * the operands of every operation are independent, `correlated_measurement<T>` records the
+ * sparse gradient of its value with respect to the independent inputs registered in an
+ * `uncertainty_tape` (forward-mode, first-order automatic differentiation). The uncertainty is
+ * evaluated from that gradient only when requested:
+ *
+ * - σ_f² = Σᵢ (∂f/∂xᵢ · σᵢ)²
+ * - cov(f, g) = Σᵢ ∂f/∂xᵢ · ∂g/∂xᵢ · σᵢ²
+ *
+ * so `x - x` is exact and derived results that share inputs have the correct covariance.
+ * Gradients are stored in the arena of the tape (sorted by input id), so an operation costs one
+ * bump allocation and a linear merge of the operands' gradients.
+ *
+ * Values of type `T` (and default-constructed measurements) are exact constants.
+ *
+ * **Example:**
+ * @code
+ * uncertainty_tape<double> tape;
+ * auto length = tape.input(10.0, 0.1) * m;  // 10.0 ± 0.1 m
+ * auto diff = length - length;              // 0 ± 0 m
+ * @endcode
+ */
+template<typename T>
+class correlated_measurement {
+public:
+  using value_type = T;
+  using term = uncertainty_tape<T>::term;
+
+  correlated_measurement() = default;
+
+  /// @brief An exact constant
+  constexpr explicit correlated_measurement(value_type val) : value_(std::move(val)) {}
+
+  /// @brief Returns the central value
+  [[nodiscard]] constexpr const value_type& value() const { return value_; }
+
+  /// @brief Returns the sensitivities to the independent inputs (sorted by input id)
+  [[nodiscard]] std::span<const term> sensitivities() const { return {terms_, size_}; }
+
+  /// @brief Returns the variance (σ²)
+  [[nodiscard]] value_type variance() const
+  {
+    value_type res{};
+    for (const term& t : sensitivities()) {
+      const value_type s = t.sensitivity * tape_->input_uncertainty(t.input);
+      res += s * s;
+    }
+    return res;
+  }
+
+  /// @brief Returns the absolute uncertainty (standard deviation)
+  [[nodiscard]] value_type uncertainty() const
+  {
+    using std::sqrt;
+    return sqrt(variance());
+  }
+
+  /// @brief Returns the relative uncertainty (σ/x)
+  [[nodiscard]] value_type relative_uncertainty() const { return uncertainty() / value(); }
+
+  /// @brief Returns the covariance of two measurements computed with the same tape
+  [[nodiscard]] friend value_type covariance(const correlated_measurement& lhs, const correlated_measurement& rhs)
+  {
+    value_type res{};
+    const term *l = lhs.terms_, *l_end = lhs.terms_ + lhs.size_;
+    const term *r = rhs.terms_, *r_end = rhs.terms_ + rhs.size_;
+    while (l != l_end && r != r_end) {
+      if (l->input < r->input)
+        ++l;
+      else if (r->input < l->input)
+        ++r;
+      else {
+        const value_type sigma = lhs.tape_->input_uncertainty(l->input);
+        res += l->sensitivity * r->sensitivity * sigma * sigma;
+        ++l;
+        ++r;
+      }
+    }
+    return res;
+  }
+
+  /// @brief Returns the Pearson correlation coefficient of two measurements
+  [[nodiscard]] friend value_type correlation(const correlated_measurement& lhs, const correlated_measurement& rhs)
+  {
+    return covariance(lhs, rhs) / (lhs.uncertainty() * rhs.uncertainty());
+  }
+
+  [[nodiscard]] correlated_measurement operator-() const { return scaled(-value_, value_type{-1}); }
+
+  [[nodiscard]] friend correlated_measurement operator+(const correlated_measurement& lhs,
+                                                        const correlated_measurement& rhs)
+  {
+    return combine(lhs.value_ + rhs.value_, lhs, value_type{1}, rhs, value_type{1});
+  }
+
+  [[nodiscard]] friend correlated_measurement operator-(const correlated_measurement& lhs,
+                                                        const correlated_measurement& rhs)
+  {
+    return combine(lhs.value_ - rhs.value_, lhs, value_type{1}, rhs, value_type{-1});
+  }
+
+  [[nodiscard]] friend correlated_measurement operator*(const correlated_measurement& lhs,
+                                                        const correlated_measurement& rhs)
+  {
+    return combine(lhs.value_ * rhs.value_, lhs, rhs.value_, rhs, lhs.value_);
+  }
+
+  [[nodiscard]] friend correlated_measurement operator/(const correlated_measurement& lhs,
+                                                        const correlated_measurement& rhs)
+  {
+    const value_type inv = value_type{1} / rhs.value_;
+    const value_type val = lhs.value_ * inv;
+    return combine(val, lhs, inv, rhs, -val * inv);
+  }
+
+  [[nodiscard]] friend correlated_measurement operator*(const correlated_measurement& lhs,
+                                                        const std::convertible_to<value_type> auto& value)
+  {
+    const auto k = static_cast<value_type>(value);
+    return lhs.scaled(lhs.value_ * k, k);
+  }
+
+  [[nodiscard]] friend correlated_measurement operator*(const std::convertible_to<value_type> auto& value,
+                                                        const correlated_measurement& rhs)
+  {
+    return rhs * value;
+  }
+
+  [[nodiscard]] friend correlated_measurement operator/(const correlated_measurement& lhs,
+                                                        const std::convertible_to<value_type> auto& value)
+  {
+    const value_type k = value_type{1} / static_cast<value_type>(value);
+    return lhs.scaled(lhs.value_ * k, k);
+  }
+
+  [[nodiscard]] friend correlated_measurement operator/(const std::convertible_to<value_type> auto& value,
+                                                        const correlated_measurement& rhs)
+  {
+    const value_type val = static_cast<value_type>(value) / rhs.value_;
+    return rhs.scaled(val, -val / rhs.value_);
+  }
+
+  /// @brief Compares the central values only
+  [[nodiscard]] friend constexpr bool operator==(const correlated_measurement& lhs, const correlated_measurement& rhs)
+  {
+    return lhs.value_ == rhs.value_;
+  }
+
+  /// @brief Compares the central values only
+  [[nodiscard]] friend constexpr auto operator<=>(const correlated_measurement& lhs, const correlated_measurement& rhs)
+  {
+    return lhs.value_ <=> rhs.value_;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const correlated_measurement& v)
+  {
+    return os << v.value() << " ± " << v.uncertainty();
+  }
+
+  [[nodiscard]] friend correlated_measurement abs(const correlated_measurement& v)
+  {
+    return v.value_ < value_type{} ? -v : v;
+  }
+
+  /// @note Formula: ∂(xⁿ)/∂x = n × xⁿ⁻¹
+  [[nodiscard]] friend correlated_measurement pow(const correlated_measurement& base, const value_type& exponent)
+  {
+    using std::pow;
+    const value_type val = pow(base.value_, exponent);
+    return base.scaled(val, exponent * val / base.value_);
+  }
+
+  /// @note Formula: ∂√x/∂x = 1 / (2√x)
+  [[nodiscard]] friend correlated_measurement sqrt(const correlated_measurement& v)
+  {
+    using std::sqrt;
+    const value_type val = sqrt(v.value_);
+    return v.scaled(val, value_type{1} / (value_type{2} * val));
+  }
+
+  /// @note Formula: ∂eˣ/∂x = eˣ
+  [[nodiscard]] friend correlated_measurement exp(const correlated_measurement& v)
+  {
+    using std::exp;
+    const value_type val = exp(v.value_);
+    return v.scaled(val, val);
+  }
+
+  /// @note Formula: ∂ln(x)/∂x = 1/x
+  [[nodiscard]] friend correlated_measurement log(const correlated_measurement& v)
+  {
+    using std::log;
+    return v.scaled(log(v.value_), value_type{1} / v.value_);
+  }
+
+private:
+  friend class uncertainty_tape<T>;
+
+  value_type value_{};
+  uncertainty_tape<T>* tape_ = nullptr;
+  const term* terms_ = nullptr;
+  std::size_t size_ = 0;
+
+  correlated_measurement(value_type val, uncertainty_tape<T>& tape, const term* terms, std::size_t size) :
+      value_(std::move(val)), tape_(&tape), terms_(terms), size_(size)
+  {
+  }
+
+  // the gradient of `val = f(*this)` with `∂f/∂x = k`
+  [[nodiscard]] correlated_measurement scaled(value_type val, const value_type& k) const
+  {
+    if (size_ == 0 || k == value_type{}) return correlated_measurement(std::move(val));
+    term* const res = tape_->arena_.template allocate<term>(size_);
+    for (std::size_t i = 0; i < size_; ++i) res[i] = term{terms_[i].input, k * terms_[i].sensitivity};
+    return correlated_measurement(std::move(val), *tape_, res, size_);
+  }
+
+  // the gradient of `val = f(lhs, rhs)` with `∂f/∂lhs = kl` and `∂f/∂rhs = kr`
+  [[nodiscard]] static correlated_measurement combine(value_type val, const correlated_measurement& lhs,
+                                                      const value_type& kl, const correlated_measurement& rhs,
+                                                      const value_type& kr)
+  {
+    if (rhs.size_ == 0) return lhs.scaled(std::move(val), kl);
+    if (lhs.size_ == 0) return rhs.scaled(std::move(val), kr);
+
+    monotonic_arena& arena = lhs.tape_->arena_;
+    const std::size_t capacity = lhs.size_ + rhs.size_;
+    term* const res = arena.template allocate<term>(capacity);
+    std::size_t n = 0;
+    const term *l = lhs.terms_, *l_end = lhs.terms_ + lhs.size_;
+    const term *r = rhs.terms_, *r_end = rhs.terms_ + rhs.size_;
+    while (l != l_end && r != r_end) {
+      if (l->input < r->input) {
+        res[n++] = term{l->input, kl * l->sensitivity};
+        ++l;
+      } else if (r->input < l->input) {
+        res[n++] = term{r->input, kr * r->sensitivity};
+        ++r;
+      } else {
+        // inputs shared by both operands: the contributions may cancel exactly (e.g. `x - x`)
+        const value_type s = kl * l->sensitivity + kr * r->sensitivity;
+        if (s != value_type{}) res[n++] = term{l->input, s};
+        ++l;
+        ++r;
+      }
+    }
+    for (; l != l_end; ++l) res[n++] = term{l->input, kl * l->sensitivity};
+    for (; r != r_end; ++r) res[n++] = term{r->input, kr * r->sensitivity};
+    arena.shrink_last(res, capacity, n);
+    if (n == 0) return correlated_measurement(std::move(val));
+    return correlated_measurement(std::move(val), *lhs.tape_, res, n);
+  }
+};
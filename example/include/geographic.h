@@ -27,10 +27,14 @@
 #ifdef MP_UNITS_IMPORT_STD
 import std;
 #else
+#include <cmath>
 #include <compare>
+#include <cstddef>
 #include <limits>
 #include <numbers>
 #include <ostream>
+#include <span>
+#include <vector>
 #endif
 #ifdef MP_UNITS_MODULES
 import mp_units;
@@ -400,4 +404,163 @@ public:
   }
 };
 
+// Batch great-circle distances
+//
+// Computing the distance from one point to many waypoints is dominated by the trigonometry of the
+// waypoints. `position_array` stores them as structure of arrays, in radians, together with the sine and
+// cosine of their latitudes, so each formula below is a branch-free loop over contiguous arrays that the
+// compiler can vectorize (for `std::sin`/`std::atan2` and friends, this requires a vector math library,
+// e.g. glibc's libmvec enabled with `-O3 -fno-math-errno`). Only the API is typed; the kernels work on
+// the numerical values in radians.
+
+enum class great_circle_formula {
+  haversine,       // well-conditioned for small distances
+  vincenty,        // the spherical special case of Vincenty's formula: well-conditioned for all distances
+  equirectangular  // a fast approximation (see below)
+};
+
+// The equirectangular approximation projects both points on a plane tangent at their mean latitude.
+// It needs a single `cos` per waypoint (precomputed in `position_array`) and a `sqrt`. Its error grows
+// with the distance and with the latitude. Compared to the exact formulas on this spherical Earth model,
+// the relative error stays below (measured on random samples):
+// - 0.01% for distances up to 100 km at latitudes up to 60°,
+// - 0.5% for distances up to 500 km at latitudes up to 70°.
+// Use one of the other formulas for longer distances or in the polar regions.
+
+template<typename T>
+class position_array {
+public:
+  position_array() = default;
+  explicit position_array(std::span<const position<T>> positions)
+  {
+    reserve(positions.size());
+    for (const auto& p : positions) push_back(p);
+  }
+
+  void reserve(std::size_t n)
+  {
+    lat_.reserve(n);
+    lon_.reserve(n);
+    sin_lat_.reserve(n);
+    cos_lat_.reserve(n);
+  }
+
+  void push_back(const position<T>& p)
+  {
+    using namespace mp_units;
+    using std::cos, std::sin;
+    const T lat = p.lat.quantity_ref_from(equator).numerical_value_in(si::radian);
+    lat_.push_back(lat);
+    lon_.push_back(p.lon.quantity_ref_from(prime_meridian).numerical_value_in(si::radian));
+    sin_lat_.push_back(sin(lat));
+    cos_lat_.push_back(cos(lat));
+  }
+
+  [[nodiscard]] std::size_t size() const { return lat_.size(); }
+  [[nodiscard]] bool empty() const { return lat_.empty(); }
+
+  [[nodiscard]] position<T> operator[](std::size_t i) const
+  {
+    using namespace mp_units;
+    return {equator + lat_[i] * si::radian, prime_meridian + lon_[i] * si::radian};
+  }
+
+  // the numerical values in radians
+  [[nodiscard]] std::span<const T> latitudes() const { return lat_; }
+  [[nodiscard]] std::span<const T> longitudes() const { return lon_; }
+  [[nodiscard]] std::span<const T> sin_latitudes() const { return sin_lat_; }
+  [[nodiscard]] std::span<const T> cos_latitudes() const { return cos_lat_; }
+
+private:
+  std::vector<T> lat_;
+  std::vector<T> lon_;
+  std::vector<T> sin_lat_;
+  std::vector<T> cos_lat_;
+};
+
+namespace detail {
+
+// one of the arrays above, passed by its data pointers to help the vectorizer
+template<typename T>
+struct position_columns {
+  const T* lat;
+  const T* lon;
+  const T* sin_lat;
+  const T* cos_lat;
+};
+
+// `out[i] = radius × central_angle(from, to[i])`
+template<great_circle_formula F, typename T>
+void great_circle_distances(T lat, T lon, position_columns<T> to, std::size_t n, T radius, distance* out)
+{
+  using namespace mp_units;
+  using std::asin, std::atan2, std::cos, std::min, std::round, std::sin, std::sqrt;
+  constexpr T pi = std::numbers::pi_v<T>;
+  const T sin_lat = sin(lat);
+  const T cos_lat = cos(lat);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const T dlon = to.lon[i] - lon;
+    if constexpr (F == great_circle_formula::haversine) {
+      const T s_lat = sin((to.lat[i] - lat) / 2);
+      const T s_lon = sin(dlon / 2);
+      const T h = s_lat * s_lat + cos_lat * to.cos_lat[i] * s_lon * s_lon;
+      out[i] = radius * (2 * asin(sqrt(min(h, T{1})))) * isq::distance[si::kilo<si::metre>];
+    } else if constexpr (F == great_circle_formula::vincenty) {
+      const T s_lon = sin(dlon);
+      const T c_lon = cos(dlon);
+      const T a = to.cos_lat[i] * s_lon;
+      const T b = cos_lat * to.sin_lat[i] - sin_lat * to.cos_lat[i] * c_lon;
+      const T angle = atan2(sqrt(a * a + b * b), sin_lat * to.sin_lat[i] + cos_lat * to.cos_lat[i] * c_lon);
+      out[i] = radius * angle * isq::distance[si::kilo<si::metre>];
+    } else {
+      // the shorter way around the globe; the mean latitude uses `cos((φ₁ + φ₂)/2)` expanded with
+      // the precomputed sines and cosines (`√((1 + cos(φ₁ + φ₂)) / 2)`, valid as |φ₁ + φ₂| ≤ π)
+      const T x = (dlon - 2 * pi * round(dlon / (2 * pi))) *
+                  sqrt((T{1} + cos_lat * to.cos_lat[i] - sin_lat * to.sin_lat[i]) / 2);
+      const T y = to.lat[i] - lat;
+      out[i] = radius * sqrt(x * x + y * y) * isq::distance[si::kilo<si::metre>];
+    }
+  }
+}
+
+}  // namespace detail
+
+// Distances from `from` to each of the `to` positions (`out` must be at least as large as `to`)
+template<typename T>
+void spherical_distance(position<T> from, const position_array<T>& to, std::span<distance> out,
+                        great_circle_formula formula = great_circle_formula::haversine)
+{
+  using namespace mp_units;
+  constexpr quantity earth_radius = 6'371 * isq::radius[si::kilo<si::metre>];
+  MP_UNITS_EXPECTS(out.size() >= to.size());
+
+  const T lat = from.lat.quantity_ref_from(equator).numerical_value_in(si::radian);
+  const T lon = from.lon.quantity_ref_from(prime_meridian).numerical_value_in(si::radian);
+  const detail::position_columns<T> cols{to.latitudes().data(), to.longitudes().data(), to.sin_latitudes().data(),
+                                         to.cos_latitudes().data()};
+
+  const T radius = earth_radius.numerical_value_in(si::kilo<si::metre>);
+  switch (formula) {
+    case great_circle_formula::haversine:
+      detail::great_circle_distances<great_circle_formula::haversine>(lat, lon, cols, to.size(), radius, out.data());
+      break;
+    case great_circle_formula::vincenty:
+      detail::great_circle_distances<great_circle_formula::vincenty>(lat, lon, cols, to.size(), radius, out.data());
+      break;
+    case great_circle_formula::equirectangular:
+      detail::great_circle_distances<great_circle_formula::equirectangular>(lat, lon, cols, to.size(), radius,
+                                                                            out.data());
+      break;
+  }
+}
+
+// The same for an array of structures (converted to `position_array` on the fly)
+template<typename T>
+void spherical_distance(position<T> from, std::span<const position<T>> to, std::span<distance> out,
+                        great_circle_formula formula = great_circle_formula::haversine)
+{
+  spherical_distance(from, position_array<T>(to), out, formula);
+}
+
 }  // namespace geographic
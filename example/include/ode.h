@@ -0,0 +1,353 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#include <mp-units/systems/isq/space_and_time.h>
+#endif
+
+namespace ode {
+
+/**
+ * @brief The state of a system of ordinary differential equations (one quantity per variable).
+ */
+template<mp_units::Quantity... Qs>
+using state = std::tuple<Qs...>;
+
+/**
+ * @brief The type of the time derivative of `Q` (`Q / T`).
+ */
+template<mp_units::Quantity Q, mp_units::QuantityOf<mp_units::isq::time> T>
+using derivative_t = mp_units::quantity<Q::reference / T::reference, double>;
+
+namespace detail {
+
+template<typename R, typename T, typename... Qs>
+inline constexpr bool is_derivative_of = false;
+
+template<typename T, typename... Ds, typename... Qs>
+  requires(sizeof...(Ds) == sizeof...(Qs))
+inline constexpr bool is_derivative_of<std::tuple<Ds...>, T, Qs...> =
+  (std::constructible_from<derivative_t<Qs, T>, Ds> && ...);
+
+struct no_observer {
+  void operator()(const auto&, const auto&) const {}
+};
+
+}  // namespace detail
+
+/**
+ * @brief A right-hand side `f(t, y)` of `dy/dt = f(t, y)` for a state of `Qs...`.
+ *
+ * `f` has to return a tuple with the derivative of every state variable, i.e. the `i`-th element
+ * has to be convertible to `Qs[i] / T` (e.g. a `speed` is accepted as the derivative of a `height`).
+ * A derivative with a wrong dimension, of a different quantity kind, or in a wrong position does
+ * not compile.
+ */
+template<typename F, typename T, typename... Qs>
+concept system_of =
+  std::regular_invocable<F&, const T&, const state<Qs...>&> &&
+  detail::is_derivative_of<std::remove_cvref_t<std::invoke_result_t<F&, const T&, const state<Qs...>&>>, T, Qs...>;
+
+/**
+ * @brief The outcome of an adaptive integration.
+ */
+template<typename T, typename... Qs>
+struct adaptive_result {
+  state<Qs...> y;         ///< the state at `time`
+  T time;                 ///< `t1` unless the integration was not `completed`
+  T step;                 ///< the step size proposed for the next step
+  std::size_t accepted;   ///< the number of accepted steps
+  std::size_t rejected;   ///< the number of rejected steps
+  bool completed = true;  ///< `false` if the step size underflowed before reaching `t1`
+};
+
+namespace detail {
+
+// Maps the typed state to a flat array of doubles (the numerical values in the units of `Qs...` and
+// `T`) and back, so that the integrators run on plain numbers. As the numerical values of `y` are in
+// `Qs::unit` and the ones of `t` in `T::unit`, the numerical values of the derivatives in
+// `Qs::unit / T::unit` are exactly the ones a raw integrator would use.
+template<typename T, typename... Qs>
+struct erased {
+  static constexpr std::size_t size = sizeof...(Qs);
+  using array = std::array<double, size>;
+  using indices = std::index_sequence_for<Qs...>;
+
+  [[nodiscard]] static array values(const state<Qs...>& y)
+  {
+    return std::apply([](const Qs&... q) { return array{static_cast<double>(q.numerical_value_in(Qs::unit))...}; },
+                      y);
+  }
+
+  [[nodiscard]] static state<Qs...> typed(const array& a)
+  {
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return state<Qs...>{static_cast<Qs::rep>(a[I]) * Qs::reference...};
+    }(indices{});
+  }
+
+  [[nodiscard]] static T time(double t) { return T{static_cast<T::rep>(t) * T::reference}; }
+
+  [[nodiscard]] static double value(const T& t) { return static_cast<double>(t.numerical_value_in(T::unit)); }
+
+  template<typename F>
+  [[nodiscard]] static array derivative(F& f, double t, const array& y)
+  {
+    const auto d = std::invoke(f, time(t), typed(y));
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return array{derivative_t<Qs, T>(std::get<I>(d)).numerical_value_in(derivative_t<Qs, T>::unit)...};
+    }(indices{});
+  }
+};
+
+template<std::size_t N>
+[[nodiscard]] std::array<double, N> axpy(const std::array<double, N>& y, double h, const std::array<double, N>& k)
+{
+  std::array<double, N> res;
+  for (std::size_t i = 0; i < N; ++i) res[i] = y[i] + h * k[i];
+  return res;
+}
+
+template<typename E, typename F>
+void rk4_step(F& f, double t, typename E::array& y, double h)
+{
+  const auto k1 = E::derivative(f, t, y);
+  const auto k2 = E::derivative(f, t + h / 2, axpy(y, h / 2, k1));
+  const auto k3 = E::derivative(f, t + h / 2, axpy(y, h / 2, k2));
+  const auto k4 = E::derivative(f, t + h, axpy(y, h, k3));
+  for (std::size_t i = 0; i < E::size; ++i) y[i] += h / 6 * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]);
+}
+
+// the Butcher tableau of the Dormand–Prince 5(4) method
+struct dormand_prince {
+  static constexpr std::array c = {0., 1. / 5, 3. / 10, 4. / 5, 8. / 9, 1., 1.};
+  static constexpr std::array<std::array<double, 6>, 7> a = {{
+    {},
+    {1. / 5},
+    {3. / 40, 9. / 40},
+    {44. / 45, -56. / 15, 32. / 9},
+    {19372. / 6561, -25360. / 2187, 64448. / 6561, -212. / 729},
+    {9017. / 3168, -355. / 33, 46732. / 5247, 49. / 176, -5103. / 18656},
+    {35. / 384, 0., 500. / 1113, 125. / 192, -2187. / 6784, 11. / 84},
+  }};
+  // the difference between the 5th and the 4th order weights (the 5th order ones are the last row of `a`)
+  static constexpr std::array e = {71. / 57600, 0., -71. / 16695, 71. / 1920, -17253. / 339200, 22. / 525, -1. / 40};
+};
+
+}  // namespace detail
+
+/**
+ * @brief Integrates `dy/dt = f(t, y)` from `t0` to `t1` with `steps` fixed steps of the classic
+ *        4th order Runge–Kutta method.
+ *
+ * The units are checked once, at compile time. The stepping runs on the numerical values of the
+ * state, so it costs the same as a hand-written RK4 on an array of doubles (plus whatever `f` costs).
+ *
+ * @param observer  called with the time and the state after every step
+ */
+template<mp_units::QuantityOf<mp_units::isq::time> T, mp_units::Quantity... Qs, system_of<T, Qs...> F,
+         std::invocable<const T&, const state<Qs...>&> Observer>
+[[nodiscard]] state<Qs...> rk4(F f, const T& t0, const state<Qs...>& y0, const std::type_identity_t<T>& t1,
+                               std::size_t steps, Observer observer)
+{
+  using E = detail::erased<T, Qs...>;
+  MP_UNITS_EXPECTS(steps > 0);
+  const double start = E::value(t0);
+  const double h = (E::value(t1) - start) / static_cast<double>(steps);
+  auto y = E::values(y0);
+  for (std::size_t i = 0; i < steps; ++i) {
+    const double t = start + static_cast<double>(i) * h;
+    detail::rk4_step<E>(f, t, y, h);
+    if constexpr (!std::is_same_v<Observer, detail::no_observer>) observer(E::time(t + h), E::typed(y));
+  }
+  return E::typed(y);
+}
+
+template<mp_units::QuantityOf<mp_units::isq::time> T, mp_units::Quantity... Qs, system_of<T, Qs...> F>
+[[nodiscard]] state<Qs...> rk4(F f, const T& t0, const state<Qs...>& y0, const std::type_identity_t<T>& t1,
+                               std::size_t steps)
+{
+  return rk4(std::move(f), t0, y0, t1, steps, detail::no_observer{});
+}
+
+/**
+ * @brief Integrates `dy/dt = f(t, y)` from `t0` to `t1` for a batch of initial states (in place).
+ *
+ * The states are processed in blocks of `Lanes` that are stored as a structure of arrays. `f` is
+ * still called once per state and stage (through the same type-erased path as the scalar overload),
+ * but the remaining work of every stage (the weighted sums of the slopes and the state updates) runs
+ * in loops over the lanes of a block. Whether the compiler vectorizes those loops, or inlines `f`
+ * into them, is not checked.
+ */
+template<std::size_t Lanes = 8, mp_units::QuantityOf<mp_units::isq::time> T, mp_units::Quantity... Qs,
+         system_of<T, Qs...> F>
+void rk4(F f, const T& t0, std::span<state<Qs...>> y, const std::type_identity_t<T>& t1, std::size_t steps)
+{
+  using E = detail::erased<T, Qs...>;
+  using block = std::array<std::array<double, Lanes>, E::size>;
+  MP_UNITS_EXPECTS(steps > 0);
+  const double start = E::value(t0);
+  const double h = (E::value(t1) - start) / static_cast<double>(steps);
+
+  const auto eval = [&](double t, const block& in, block& out) {
+    for (std::size_t l = 0; l < Lanes; ++l) {
+      typename E::array v;
+      for (std::size_t i = 0; i < E::size; ++i) v[i] = in[i][l];
+      const auto d = E::derivative(f, t, v);
+      for (std::size_t i = 0; i < E::size; ++i) out[i][l] = d[i];
+    }
+  };
+  const auto axpy = [](const block& b, double a, const block& k, block& out) {
+    for (std::size_t i = 0; i < E::size; ++i)
+      for (std::size_t l = 0; l < Lanes; ++l) out[i][l] = b[i][l] + a * k[i][l];
+  };
+
+  for (std::size_t first = 0; first < y.size(); first += Lanes) {
+    const std::size_t count = std::min(Lanes, y.size() - first);
+    block b{};
+    for (std::size_t l = 0; l < count; ++l) {
+      const auto v = E::values(y[first + l]);
+      for (std::size_t i = 0; i < E::size; ++i) b[i][l] = v[i];
+    }
+    // the unused lanes of the last block repeat its first state, so `f` sees only valid states
+    for (std::size_t l = count; l < Lanes; ++l)
+      for (std::size_t i = 0; i < E::size; ++i) b[i][l] = b[i][0];
+
+    block k1, k2, k3, k4, tmp;
+    for (std::size_t s = 0; s < steps; ++s) {
+      const double t = start + static_cast<double>(s) * h;
+      eval(t, b, k1);
+      axpy(b, h / 2, k1, tmp);
+      eval(t + h / 2, tmp, k2);
+      axpy(b, h / 2, k2, tmp);
+      eval(t + h / 2, tmp, k3);
+      axpy(b, h, k3, tmp);
+      eval(t + h, tmp, k4);
+      for (std::size_t i = 0; i < E::size; ++i)
+        for (std::size_t l = 0; l < Lanes; ++l) b[i][l] += h / 6 * (k1[i][l] + 2 * k2[i][l] + 2 * k3[i][l] + k4[i][l]);
+    }
+
+    for (std::size_t l = 0; l < count; ++l) {
+      typename E::array v;
+      for (std::size_t i = 0; i < E::size; ++i) v[i] = b[i][l];
+      y[first + l] = E::typed(v);
+    }
+  }
+}
+
+/**
+ * @brief Integrates `dy/dt = f(t, y)` from `t0` to `t1` with the adaptive Dormand–Prince 5(4) method.
+ *
+ * A step is accepted if the estimated local error of every variable is below
+ * `abs_tol[i] + rel_tol * |y[i]|`, so the absolute tolerances are quantities of the same types as
+ * the state. The step size is a time quantity (`h0` is the first trial step) and is adapted after
+ * every step.
+ */
+template<mp_units::QuantityOf<mp_units::isq::time> T, mp_units::Quantity... Qs, system_of<T, Qs...> F>
+[[nodiscard]] adaptive_result<T, Qs...> rk45(F f, const T& t0, const state<Qs...>& y0,
+                                             const std::type_identity_t<T>& t1, const std::type_identity_t<T>& h0,
+                                             double rel_tol, const std::type_identity_t<state<Qs...>>& abs_tol)
+{
+  using E = detail::erased<T, Qs...>;
+  using tableau = detail::dormand_prince;
+  constexpr double safety = 0.9;
+  constexpr double min_factor = 0.2;
+  constexpr double max_factor = 5.;
+
+  const double end = E::value(t1);
+  const double direction = end >= E::value(t0) ? 1. : -1.;
+  const double min_step = 1e-12 * std::abs(end - E::value(t0));
+  const auto atol = E::values(abs_tol);
+  MP_UNITS_EXPECTS(E::value(h0) * direction > 0);
+
+  double t = E::value(t0);
+  double h = E::value(h0);
+  auto y = E::values(y0);
+  std::array<typename E::array, 7> k;
+  k[0] = E::derivative(f, t, y);
+  adaptive_result<T, Qs...> res{y0, t0, h0, 0, 0};
+
+  while ((end - t) * direction > 0) {
+    if ((t + h - end) * direction > 0) h = end - t;
+
+    for (std::size_t s = 1; s < 7; ++s) {
+      auto tmp = y;
+      for (std::size_t j = 0; j < s; ++j)
+        for (std::size_t i = 0; i < E::size; ++i) tmp[i] += h * tableau::a[s][j] * k[j][i];
+      k[s] = E::derivative(f, t + tableau::c[s] * h, tmp);
+    }
+    // the 5th order solution is the argument of the last stage (FSAL)
+    auto next = y;
+    for (std::size_t j = 0; j < 6; ++j)
+      for (std::size_t i = 0; i < E::size; ++i) next[i] += h * tableau::a[6][j] * k[j][i];
+
+    double err = 0;
+    for (std::size_t i = 0; i < E::size; ++i) {
+      double e = 0;
+      for (std::size_t j = 0; j < 7; ++j) e += tableau::e[j] * k[j][i];
+      const double scale = atol[i] + rel_tol * std::max(std::abs(y[i]), std::abs(next[i]));
+      err = std::max(err, std::abs(h * e) / scale);
+    }
+
+    const double factor = err == 0 ? max_factor : std::clamp(safety * std::pow(err, -0.2), min_factor, max_factor);
+    if (err <= 1) {
+      t += h;
+      y = next;
+      k[0] = k[6];
+      ++res.accepted;
+    } else {
+      ++res.rejected;
+    }
+    h *= err <= 1 ? factor : std::min(factor, 1.);
+    if (std::abs(h) < min_step) {
+      res.completed = false;
+      break;
+    }
+  }
+
+  res.y = E::typed(y);
+  res.time = E::time(t);
+  res.step = E::time(h);
+  return res;
+}
+
+}  // namespace ode
@@ -0,0 +1,291 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "geographic.h"
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+#endif
+
+namespace geographic {
+
+struct neighbour {
+  std::size_t index;  // the position of the point in the indexed range
+  distance dist;      // the great-circle distance
+};
+
+// A static spatial index of geographic positions for nearest-neighbour and radius queries.
+//
+// The positions are mapped to points on the unit sphere and stored in an implicit, balanced k-d tree
+// (the median of every subrange is its root). The chord between two points on a sphere grows
+// monotonically with the great-circle distance, so the tree needs no special handling of the
+// antimeridian or the poles, and the distances are converted to and from chords only at the API.
+//
+// The construction takes O(n log n). The queries are recursive over the subranges of the tree and
+// never allocate: k-NN results are written to a caller-provided span, and radius queries report their
+// results to a callback.
+template<typename T = double>
+class position_index {
+public:
+  position_index() = default;
+
+  explicit position_index(std::span<const position<T>> positions) : nodes_(make_nodes(positions))
+  {
+    build(0, nodes_.size());
+  }
+
+  // Builds the subtrees in parallel with the given execution policy (e.g. `std::execution::par`)
+  template<typename ExecutionPolicy>
+    requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+  position_index(ExecutionPolicy&& policy, std::span<const position<T>> positions) : nodes_(make_nodes(positions))
+  {
+    // split the top levels sequentially until there are enough independent subtrees for all threads
+    const std::size_t tasks = 4 * std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::pair<std::size_t, std::size_t>> subtrees{{0, nodes_.size()}};
+    while (subtrees.size() < tasks) {
+      std::vector<std::pair<std::size_t, std::size_t>> next;
+      for (const auto& [lo, hi] : subtrees) {
+        if (hi - lo < 2 * leaf_task_size) {
+          next.emplace_back(lo, hi);
+          continue;
+        }
+        const std::size_t mid = split(lo, hi);
+        next.emplace_back(lo, mid);
+        next.emplace_back(mid + 1, hi);
+      }
+      if (next.size() == subtrees.size()) break;
+      subtrees = std::move(next);
+    }
+    std::for_each(std::forward<ExecutionPolicy>(policy), subtrees.begin(), subtrees.end(),
+                  [this](const std::pair<std::size_t, std::size_t>& s) { build(s.first, s.second); });
+  }
+
+  [[nodiscard]] std::size_t size() const { return nodes_.size(); }
+  [[nodiscard]] bool empty() const { return nodes_.empty(); }
+
+  // Finds the `out.size()` nearest positions sorted by distance; returns the number of results
+  std::size_t nearest(const position<T>& pos, std::span<neighbour> out) const
+  {
+    if (out.empty()) return 0;
+    knn_query q{to_unit_vector(pos), out};
+    nearest(0, nodes_.size(), q);
+    const auto found = out.first(q.count);
+    std::sort_heap(found.begin(), found.end(), by_chord);
+    for (neighbour& n : found) n.dist = to_distance(chord2_of(n));
+    return q.count;
+  }
+
+  [[nodiscard]] std::optional<neighbour> nearest(const position<T>& pos) const
+  {
+    std::array<neighbour, 1> res;
+    if (nearest(pos, res) == 0) return std::nullopt;
+    return res[0];
+  }
+
+  // Calls `f(neighbour)` for every position within `radius` (in no particular order)
+  template<std::invocable<const neighbour&> F>
+  void for_each_within(const position<T>& pos, distance radius, F&& f) const
+  {
+    const T c = chord(radius);
+    within(0, nodes_.size(), to_unit_vector(pos), c * c, f);
+  }
+
+  [[nodiscard]] std::size_t count_within(const position<T>& pos, distance radius) const
+  {
+    std::size_t res = 0;
+    for_each_within(pos, radius, [&](const neighbour&) { ++res; });
+    return res;
+  }
+
+private:
+  using vec3 = std::array<T, 3>;
+
+  struct node {
+    vec3 p;
+    std::uint32_t index;
+    std::uint8_t axis;
+  };
+
+  // `out` is a max-heap of the best results so far; until the search ends, the `dist` of every result
+  // holds its exact squared chord, which is converted to a distance only once at the end
+  struct knn_query {
+    vec3 p;
+    std::span<neighbour> out;
+    std::size_t count = 0;
+
+    // whether a result (or a subtree) at the squared chord `c2` may improve the results
+    [[nodiscard]] bool accepts(T c2) const { return count < out.size() || c2 < chord2_of(out.front()); }
+  };
+
+  static constexpr std::size_t leaf_task_size = 1024;
+  static constexpr auto earth_radius = 6'371 * mp_units::isq::radius[mp_units::si::kilo<mp_units::si::metre>];
+
+  std::vector<node> nodes_;
+
+  [[nodiscard]] static neighbour candidate(std::size_t index, T chord2)
+  {
+    return {index, static_cast<double>(chord2) * distance::reference};
+  }
+  [[nodiscard]] static T chord2_of(const neighbour& n)
+  {
+    return static_cast<T>(n.dist.numerical_value_in(distance::unit));
+  }
+  static constexpr bool by_chord(const neighbour& lhs, const neighbour& rhs) { return lhs.dist < rhs.dist; }
+
+  [[nodiscard]] static vec3 to_unit_vector(const position<T>& pos)
+  {
+    using namespace mp_units;
+    using std::cos, std::sin;
+    const T lat = pos.lat.quantity_ref_from(equator).numerical_value_in(si::radian);
+    const T lon = pos.lon.quantity_ref_from(prime_meridian).numerical_value_in(si::radian);
+    return {cos(lat) * cos(lon), cos(lat) * sin(lon), sin(lat)};
+  }
+
+  [[nodiscard]] static T squared_chord(const vec3& a, const vec3& b)
+  {
+    const T dx = a[0] - b[0];
+    const T dy = a[1] - b[1];
+    const T dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+  }
+
+  // chord = 2 sin(θ/2), θ = distance / R
+  [[nodiscard]] static T chord(distance d)
+  {
+    using std::min, std::sin;
+    const T angle = static_cast<T>((d / earth_radius).numerical_value_in(mp_units::one));
+    return 2 * sin(min(angle, std::numbers::pi_v<T>) / 2);
+  }
+
+  [[nodiscard]] static distance to_distance(T squared_chord)
+  {
+    using std::asin, std::min, std::sqrt;
+    const T angle = 2 * asin(min(sqrt(squared_chord) / 2, T{1}));
+    return mp_units::quantity_cast<mp_units::isq::distance>(angle * earth_radius);
+  }
+
+  [[nodiscard]] static std::vector<node> make_nodes(std::span<const position<T>> positions)
+  {
+    MP_UNITS_EXPECTS(positions.size() <= std::numeric_limits<std::uint32_t>::max());
+    std::vector<node> res;
+    res.reserve(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i)
+      res.push_back({to_unit_vector(positions[i]), static_cast<std::uint32_t>(i), 0});
+    return res;
+  }
+
+  // makes the median along the axis of the largest spread the root of [lo, hi); returns its position
+  std::size_t split(std::size_t lo, std::size_t hi)
+  {
+    vec3 min_p = nodes_[lo].p;
+    vec3 max_p = nodes_[lo].p;
+    for (std::size_t i = lo + 1; i < hi; ++i)
+      for (std::size_t a = 0; a < 3; ++a) {
+        min_p[a] = std::min(min_p[a], nodes_[i].p[a]);
+        max_p[a] = std::max(max_p[a], nodes_[i].p[a]);
+      }
+    std::uint8_t axis = 0;
+    for (std::uint8_t a = 1; a < 3; ++a)
+      if (max_p[a] - min_p[a] > max_p[axis] - min_p[axis]) axis = a;
+
+    const std::size_t mid = lo + (hi - lo) / 2;
+    const auto first = nodes_.begin() + static_cast<std::ptrdiff_t>(lo);
+    std::nth_element(first, nodes_.begin() + static_cast<std::ptrdiff_t>(mid),
+                     nodes_.begin() + static_cast<std::ptrdiff_t>(hi),
+                     [axis](const node& l, const node& r) { return l.p[axis] < r.p[axis]; });
+    nodes_[mid].axis = axis;
+    return mid;
+  }
+
+  void build(std::size_t lo, std::size_t hi)
+  {
+    if (hi - lo < 2) return;
+    const std::size_t mid = split(lo, hi);
+    build(lo, mid);
+    build(mid + 1, hi);
+  }
+
+  void nearest(std::size_t lo, std::size_t hi, knn_query& q) const
+  {
+    if (lo >= hi) return;
+    const std::size_t mid = lo + (hi - lo) / 2;
+    const node& n = nodes_[mid];
+
+    const T d2 = squared_chord(q.p, n.p);
+    if (q.accepts(d2)) {
+      if (q.count == q.out.size()) std::pop_heap(q.out.begin(), q.out.end(), by_chord);
+      else
+        ++q.count;
+      q.out[q.count - 1] = candidate(n.index, d2);
+      std::push_heap(q.out.begin(), q.out.begin() + static_cast<std::ptrdiff_t>(q.count), by_chord);
+    }
+    if (hi - lo == 1) return;
+
+    const T diff = q.p[n.axis] - n.p[n.axis];
+    const auto [near_lo, near_hi, far_lo, far_hi] =
+      diff < 0 ? std::array{lo, mid, mid + 1, hi} : std::array{mid + 1, hi, lo, mid};
+    nearest(near_lo, near_hi, q);
+    if (q.accepts(diff * diff)) nearest(far_lo, far_hi, q);
+  }
+
+  template<typename F>
+  void within(std::size_t lo, std::size_t hi, const vec3& p, T max_chord2, F& f) const
+  {
+    if (lo >= hi) return;
+    const std::size_t mid = lo + (hi - lo) / 2;
+    const node& n = nodes_[mid];
+
+    const T d2 = squared_chord(p, n.p);
+    if (d2 <= max_chord2) std::invoke(f, neighbour{n.index, to_distance(d2)});
+
+    const T diff = p[n.axis] - n.p[n.axis];
+    if (diff < 0 || diff * diff <= max_chord2) within(lo, mid, p, max_chord2, f);
+    if (diff >= 0 || diff * diff <= max_chord2) within(mid + 1, hi, p, max_chord2, f);
+  }
+};
+
+}  // namespace geographic
@@ -0,0 +1,208 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <ranges>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/framework.h>
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+#endif
+
+template<typename T>
+concept TimeSeriesValue = mp_units::Quantity<T> || mp_units::QuantityPoint<T>;
+
+namespace detail {
+
+// the integrand of a sample: a point is integrated as its displacement from its own origin
+template<TimeSeriesValue T>
+[[nodiscard]] constexpr mp_units::Quantity auto integrand(const T& v)
+{
+  if constexpr (mp_units::QuantityPoint<T>)
+    return v.quantity_from(T::point_origin);
+  else
+    return v;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A fixed-capacity stream of timestamped samples with running integrals and derivatives.
+ *
+ * The samples are stored in a ring buffer of `N` elements, so a stream uses the same amount of
+ * memory no matter how long it runs: when the buffer is full, every new sample evicts the oldest
+ * one. The integrals (trapezoidal rule) are maintained incrementally on every `push()`, both for
+ * the whole stream and for the samples currently in the window, so all the queries are O(1). The
+ * results have the units implied by the samples, e.g. a `velocity` for the rate of an altitude
+ * and an `energy` for the integral of a power.
+ *
+ * The window can be read back through lazy views that re-express every sample in another unit
+ * (`values_in()`) or relative to another origin (`values_for()`) without copying the buffer.
+ *
+ * @note The window integral is updated by adding the newest and subtracting the evicted trapezoid,
+ *       so with floating-point representation types it accumulates rounding errors over very long
+ *       streams.
+ *
+ * @tparam V   the type of the samples (a quantity or a quantity point)
+ * @tparam N   the capacity of the window
+ * @tparam TP  the type of the timestamps
+ */
+template<TimeSeriesValue V, std::size_t N,
+         mp_units::QuantityPointOf<mp_units::isq::time> TP =
+           mp_units::quantity_point<mp_units::isq::time[mp_units::si::second],
+                                    mp_units::chrono_point_origin<std::chrono::steady_clock>>>
+  requires(N >= 2)
+class time_series {
+public:
+  using value_type = V;
+  using timestamp = TP;
+  using duration = TP::quantity_type;
+  using rate_type = decltype((V{} - V{}) / duration{});
+  using integral_type = decltype(detail::integrand(V{}) * duration{});
+
+  struct sample {
+    timestamp time;
+    value_type value;
+  };
+
+  static constexpr std::size_t capacity = N;
+
+  /**
+   * @brief Appends a new sample (its timestamp has to be later than the one of the newest sample).
+   */
+  void push(const timestamp& t, const value_type& v)
+  {
+    if (size_ > 0) {
+      const sample& last = newest();
+      MP_UNITS_EXPECTS(t > last.time);
+      const duration dt = t - last.time;
+      const integral_type area = trapezoid(last, {t, v});
+      rate_ = (v - last.value) / dt;
+      integral_ += area;
+      window_integral_ += area;
+    }
+    if (size_ == N) {
+      window_integral_ -= trapezoid(buffer_[head_], buffer_[(head_ + 1) % N]);
+      buffer_[head_] = {t, v};
+      head_ = (head_ + 1) % N;
+    } else {
+      buffer_[(head_ + size_) % N] = {t, v};
+      ++size_;
+    }
+  }
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] bool full() const { return size_ == N; }
+
+  /**
+   * @brief The sample at position `i` of the window (`0` is the oldest one).
+   */
+  [[nodiscard]] const sample& operator[](std::size_t i) const
+  {
+    MP_UNITS_EXPECTS_DEBUG(i < size_);
+    return buffer_[(head_ + i) % N];
+  }
+
+  [[nodiscard]] const sample& oldest() const { return (*this)[0]; }
+  [[nodiscard]] const sample& newest() const { return (*this)[size_ - 1]; }
+
+  /**
+   * @brief The time between the oldest and the newest sample in the window.
+   */
+  [[nodiscard]] duration window_duration() const { return size_ < 2 ? duration{} : newest().time - oldest().time; }
+
+  /**
+   * @brief The derivative between the two newest samples.
+   */
+  [[nodiscard]] rate_type rate() const { return rate_; }
+
+  /**
+   * @brief The mean derivative over the window.
+   */
+  [[nodiscard]] rate_type mean_rate() const
+  {
+    return size_ < 2 ? rate_type{} : (newest().value - oldest().value) / window_duration();
+  }
+
+  /**
+   * @brief The integral since the first sample of the stream.
+   */
+  [[nodiscard]] integral_type integral() const { return integral_; }
+
+  /**
+   * @brief The integral over the window.
+   */
+  [[nodiscard]] integral_type window_integral() const { return window_integral_; }
+
+  /**
+   * @brief A view of the samples in the window (from the oldest to the newest).
+   */
+  [[nodiscard]] std::ranges::view auto samples() const
+  {
+    return std::views::iota(std::size_t{0}, size_) |
+           std::views::transform([this](std::size_t i) -> const sample& { return (*this)[i]; });
+  }
+
+  /**
+   * @brief A view of the values in the window expressed in unit `u`.
+   */
+  template<mp_units::Unit U>
+  [[nodiscard]] std::ranges::view auto values_in(U u) const
+  {
+    return samples() | std::views::transform([u](const sample& s) { return s.value.in(u); });
+  }
+
+  /**
+   * @brief A view of the values in the window expressed relative to `origin`.
+   */
+  template<mp_units::PointOrigin PO>
+    requires mp_units::QuantityPoint<V>
+  [[nodiscard]] std::ranges::view auto values_for(PO origin) const
+  {
+    return samples() | std::views::transform([origin](const sample& s) { return s.value.point_for(origin); });
+  }
+
+private:
+  std::array<sample, N> buffer_{};
+  std::size_t head_ = 0;  // the index of the oldest sample
+  std::size_t size_ = 0;
+  rate_type rate_{};
+  integral_type integral_{};
+  integral_type window_integral_{};
+
+  [[nodiscard]] static integral_type trapezoid(const sample& from, const sample& to)
+  {
+    return (detail::integrand(from.value) + detail::integrand(to.value)) / 2 * (to.time - from.time);
+  }
+};
@@ -28,13 +28,18 @@
 import std;
 #else
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <locale>
+#include <span>
 #include <tuple>
+#include <vector>
 #endif
 #ifdef MP_UNITS_MODULES
 import mp_units;
 #else
 #include <mp-units/ext/algorithm.h>
+#include <mp-units/ext/contracts.h>
 #include <mp-units/framework/quantity.h>
 #include <mp-units/framework/quantity_point.h>
 #include <mp-units/math.h>
@@ -190,6 +195,140 @@ template<mp_units::Quantity Q1, mp_units::Quantity Q2>
   return uncertainty + process_noise_variance;
 }
 
+
+// batch of independent tracks
+// Stores the state variables, variances, and gains of all the tracks in separate contiguous
+// arrays (SoA), so every filter step is a tight loop of `fma` calls over plain values that the
+// compiler can vectorize. Units are checked once, on the API boundary, against `QPs...`.
+template<mp_units::QuantityPoint QP, mp_units::QuantityPoint... Rest>
+  requires requires { typename system_state<QP, Rest...>; }
+class batch_filter {
+public:
+  using state_type = system_state<QP, Rest...>;
+  using estimate_type = system_state_estimate<QP, Rest...>;
+  using variance_type = estimate_type::variance_type;
+  using gain_type = mp_units::quantity<mp_units::dimensionless[mp_units::one], typename QP::rep>;
+  static constexpr std::size_t state_size = 1 + sizeof...(Rest);
+private:
+  std::tuple<std::vector<QP>, std::vector<Rest>...> states_;
+  std::vector<variance_type> variances_;
+  std::vector<gain_type> gains_;
+
+  [[nodiscard]] static constexpr auto to_quantity(const mp_units::QuantityPoint auto& qp)
+  {
+    return qp.quantity_ref_from(qp.point_origin);
+  }
+
+  template<std::size_t... Is>
+  [[nodiscard]] state_type state(std::size_t track, std::index_sequence<Is...>) const
+  {
+    return state_type{std::get<Is>(states_)[track]...};
+  }
+public:
+  batch_filter() = default;
+
+  void reserve(std::size_t tracks)
+  {
+    std::apply([&](auto&... v) { (v.reserve(tracks), ...); }, states_);
+    variances_.reserve(tracks);
+    gains_.reserve(tracks);
+  }
+
+  std::size_t add_track(const estimate_type& initial)
+  {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (std::get<Is>(states_).push_back(get<Is>(initial.state())), ...);
+    }(std::make_index_sequence<state_size>{});
+    variances_.push_back(initial.variance());
+    gains_.push_back(gain_type::zero());
+    return size() - 1;
+  }
+
+  [[nodiscard]] std::size_t size() const { return variances_.size(); }
+  [[nodiscard]] state_type state(std::size_t track) const
+  {
+    return state(track, std::make_index_sequence<state_size>{});
+  }
+  [[nodiscard]] estimate_type estimate(std::size_t track) const { return {state(track), variances_[track]}; }
+  [[nodiscard]] const variance_type& variance(std::size_t track) const { return variances_[track]; }
+  [[nodiscard]] const gain_type& gain(std::size_t track) const { return gains_[track]; }
+
+  // state extrapolation of all the tracks
+  template<mp_units::QuantityOf<mp_units::isq::duration> T>
+    requires(state_size > 1)
+  void state_extrapolation(T interval)
+  {
+    auto& x = std::get<0>(states_);
+    auto& v = std::get<1>(states_);
+    if constexpr (state_size == 2) {
+      for (std::size_t i = 0; i < x.size(); ++i) x[i] = fma(to_quantity(v[i]), interval, x[i]);
+    } else {
+      auto& a = std::get<2>(states_);
+      const auto half_interval_squared = pow<2>(interval) / 2;
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        x[i] = fma(to_quantity(a[i]), half_interval_squared, fma(to_quantity(v[i]), interval, x[i]));
+        v[i] = fma(to_quantity(a[i]), interval, v[i]);
+      }
+    }
+  }
+
+  // covariance extrapolation of all the tracks
+  template<mp_units::Quantity Q>
+    requires requires { mp_units::get_common_reference(variance_type::reference, Q::reference); }
+  void covariance_extrapolation(Q process_noise_variance)
+  {
+    const variance_type noise = process_noise_variance;
+    for (auto& var : variances_) var += noise;
+  }
+
+  // one-dimensional Kalman update of all the tracks with the measurements taken in the same order as
+  // the tracks were added (computes the Kalman gain, and updates the state and the covariance)
+  template<mp_units::QuantityPoint QM, mp_units::Quantity Q>
+    requires(state_size == 1) && (implicitly_convertible(QM::quantity_spec, QP::quantity_spec)) &&
+            requires { mp_units::get_common_reference(variance_type::reference, Q::reference); }
+  void state_estimate_update(std::span<const QM> measured, Q measurement_variance)
+  {
+    MP_UNITS_EXPECTS(measured.size() == size());
+    auto& x = std::get<0>(states_);
+    const variance_type r = measurement_variance;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      const gain_type k = variances_[i] / (variances_[i] + r);
+      x[i] = fma(k, measured[i] - x[i], x[i]);
+      variances_[i] = (1 * mp_units::one - k) * variances_[i];
+      gains_[i] = k;
+    }
+  }
+
+  // fixed-gain (α-β or α-β-γ) state update of all the tracks
+  template<mp_units::QuantityPoint QM, mp_units::QuantityOf<mp_units::dimensionless> K,
+           mp_units::QuantityOf<mp_units::isq::duration> T>
+    requires(state_size > 1) && (implicitly_convertible(QM::quantity_spec, QP::quantity_spec))
+  void state_update(std::span<const QM> measured, std::array<K, state_size> gain, T interval)
+  {
+    MP_UNITS_EXPECTS(measured.size() == size());
+    auto& x = std::get<0>(states_);
+    auto& v = std::get<1>(states_);
+    const auto beta = get<1>(gain) / interval;
+    if constexpr (state_size == 2) {
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        const auto residual = measured[i] - x[i];
+        v[i] = fma(beta, residual, v[i]);
+        x[i] = fma(get<0>(gain), residual, x[i]);
+      }
+    } else {
+      auto& a = std::get<2>(states_);
+      const auto gamma = get<2>(gain) / (interval * interval / 2);
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        const auto residual = measured[i] - x[i];
+        a[i] = fma(gamma, residual, a[i]);
+        v[i] = fma(beta, residual, v[i]);
+        x[i] = fma(get<0>(gain), residual, x[i]);
+      }
+    }
+    std::ranges::fill(gains_, gain_type{get<0>(gain)});
+  }
+};
+
 }  // namespace kalman
 
 template<typename... QPs, typename Char>
@@ -0,0 +1,287 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+// Multivariate (matrix-form) Kalman filter on top of the Eigen integration.
+//
+// A state vector of a multivariate filter mixes quantities of different kinds (e.g. position and
+// velocity), so neither the vector nor its covariance matrix can be a single `quantity`, and a
+// matrix of individual `quantity` objects would prevent Eigen from doing the numerics. Instead,
+// the unit of every element is encoded in the type: a `basis` lists the reference of each element
+// of a vector, and a `matrix<Rows, Cols>` has the element `(i, j)` expressed in
+// `Rows[i] / Cols[j]`. With this representation, all the matrices of a Kalman filter are
+// dimensionally consistent by construction, e.g.:
+// - state transition `F`:          `matrix<S, S>`        (`Sᵢ / Sⱼ`),
+// - state covariance `P`:          `matrix<S, dual<S>>`  (`Sᵢ · Sⱼ`),
+// - observation `H`:               `matrix<M, S>`        (`Mᵢ / Sⱼ`),
+// - Kalman gain `K`:               `matrix<S, M>`        (`Sᵢ / Mⱼ`),
+// and the only thing checked during matrix operations is that the inner bases match. Units are
+// converted only when individual elements are read or written, while the whole filter step runs
+// on dense Eigen matrices of `double`.
+
+#include <mp-units/compat_macros.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#endif
+#include <Eigen/Core>
+#include <Eigen/LU>
+#ifdef MP_UNITS_MODULES
+import mp_units;
+import mp_units.integrations.eigen;
+#else
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/reference.h>
+#include <mp-units/integrations/eigen.h>
+#endif
+
+namespace kalman {
+
+// the references of the elements of a vector space (or of its dual when `Inverted`)
+template<bool Inverted, mp_units::Reference auto... Rs>
+  requires(sizeof...(Rs) > 0)
+struct basis {
+  static constexpr int size = sizeof...(Rs);
+
+  template<std::size_t I>
+    requires(I < sizeof...(Rs))
+  [[nodiscard]] static consteval mp_units::Reference auto reference()
+  {
+    constexpr mp_units::Reference auto r = std::get<I>(std::tuple{Rs...});
+    if constexpr (Inverted)
+      return inverse(r);
+    else
+      return r;
+  }
+};
+
+namespace detail {
+
+template<typename T>
+constexpr bool is_basis = false;
+
+template<bool Inverted, auto... Rs>
+constexpr bool is_basis<basis<Inverted, Rs...>> = true;
+
+template<typename T>
+struct dual_impl;
+
+template<bool Inverted, auto... Rs>
+struct dual_impl<basis<Inverted, Rs...>> {
+  using type = basis<!Inverted, Rs...>;
+};
+
+}  // namespace detail
+
+template<typename T>
+concept Basis = detail::is_basis<T>;
+
+template<mp_units::Reference auto... Rs>
+using space = basis<false, Rs...>;
+
+// the basis with inverted references (e.g. the columns of a covariance matrix)
+template<Basis B>
+using dual = detail::dual_impl<B>::type;
+
+
+// vector with the element `I` expressed in `B::reference<I>()`
+template<Basis B>
+class vector {
+public:
+  using basis_type = B;
+  using eigen_type = Eigen::Matrix<double, B::size, 1>;
+
+  eigen_type values = eigen_type::Zero();
+
+  vector() = default;
+  explicit vector(const eigen_type& v) : values(v) {}
+
+  template<mp_units::Quantity... Qs>
+    requires(sizeof...(Qs) == B::size)
+  explicit vector(const Qs&... qs)
+  {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (set<Is>(qs), ...);
+    }(std::index_sequence_for<Qs...>{});
+  }
+
+  template<std::size_t I>
+  [[nodiscard]] mp_units::Quantity auto get() const
+  {
+    return values(static_cast<Eigen::Index>(I)) * B::template reference<I>();
+  }
+
+  template<std::size_t I, mp_units::Quantity Q>
+    requires std::convertible_to<Q, mp_units::quantity<B::template reference<I>(), double>>
+  void set(const Q& q)
+  {
+    const mp_units::quantity<B::template reference<I>(), double> v = q;
+    values(static_cast<Eigen::Index>(I)) = v.numerical_value_in(v.unit);
+  }
+
+  // `Count` consecutive elements of the same reference as a single Eigen-backed quantity
+  template<std::size_t Offset, std::size_t Count>
+    requires(Offset + Count <= B::size) && ([]<std::size_t... Is>(std::index_sequence<Is...>) {
+              return (std::is_same_v<decltype(B::template reference<Offset + Is>()),
+                                     decltype(B::template reference<Offset>())> &&
+                      ...);
+            }(std::make_index_sequence<Count>{}))
+  [[nodiscard]] mp_units::Quantity auto segment() const
+  {
+    return mp_units::quantity{
+      Eigen::Matrix<double, static_cast<int>(Count), 1>{values.template segment<static_cast<int>(Count)>(Offset)},
+      B::template reference<Offset>()};
+  }
+
+  [[nodiscard]] friend vector operator+(const vector& lhs, const vector& rhs)
+  {
+    return vector{lhs.values + rhs.values};
+  }
+  [[nodiscard]] friend vector operator-(const vector& lhs, const vector& rhs)
+  {
+    return vector{lhs.values - rhs.values};
+  }
+};
+
+// matrix with the element `(I, J)` expressed in `Rows::reference<I>() / Cols::reference<J>()`
+template<Basis Rows, Basis Cols>
+class matrix {
+public:
+  using row_basis_type = Rows;
+  using column_basis_type = Cols;
+  using eigen_type = Eigen::Matrix<double, Rows::size, Cols::size>;
+
+  eigen_type values = eigen_type::Zero();
+
+  matrix() = default;
+  explicit matrix(const eigen_type& m) : values(m) {}
+
+  [[nodiscard]] static matrix identity()
+    requires std::same_as<Rows, Cols>
+  {
+    return matrix{eigen_type::Identity()};
+  }
+
+  template<std::size_t I, std::size_t J>
+  [[nodiscard]] static consteval mp_units::Reference auto reference()
+  {
+    return Rows::template reference<I>() / Cols::template reference<J>();
+  }
+
+  template<std::size_t I, std::size_t J>
+  [[nodiscard]] mp_units::Quantity auto get() const
+  {
+    return values(static_cast<Eigen::Index>(I), static_cast<Eigen::Index>(J)) * reference<I, J>();
+  }
+
+  template<std::size_t I, std::size_t J, mp_units::Quantity Q>
+    requires std::convertible_to<Q, mp_units::quantity<reference<I, J>(), double>>
+  void set(const Q& q)
+  {
+    const mp_units::quantity<reference<I, J>(), double> v = q;
+    values(static_cast<Eigen::Index>(I), static_cast<Eigen::Index>(J)) = v.numerical_value_in(v.unit);
+  }
+
+  [[nodiscard]] friend matrix operator+(const matrix& lhs, const matrix& rhs)
+  {
+    return matrix{lhs.values + rhs.values};
+  }
+  [[nodiscard]] friend matrix operator-(const matrix& lhs, const matrix& rhs)
+  {
+    return matrix{lhs.values - rhs.values};
+  }
+};
+
+template<Basis A, Basis B, Basis C>
+[[nodiscard]] matrix<A, C> operator*(const matrix<A, B>& lhs, const matrix<B, C>& rhs)
+{
+  return matrix<A, C>{lhs.values * rhs.values};
+}
+
+template<Basis A, Basis B>
+[[nodiscard]] vector<A> operator*(const matrix<A, B>& lhs, const vector<B>& rhs)
+{
+  return vector<A>{lhs.values * rhs.values};
+}
+
+template<Basis A, Basis B>
+[[nodiscard]] matrix<dual<B>, dual<A>> transpose(const matrix<A, B>& m)
+{
+  return matrix<dual<B>, dual<A>>{m.values.transpose()};
+}
+
+template<Basis A, Basis B>
+  requires(A::size == B::size)
+[[nodiscard]] matrix<B, A> inverse(const matrix<A, B>& m)
+{
+  return matrix<B, A>{m.values.inverse()};
+}
+
+
+// multivariate Kalman filter with the state in `S` and the measurements in `M`
+template<Basis S, Basis M>
+class multivariate_filter {
+public:
+  using state_vector = vector<S>;
+  using covariance_matrix = matrix<S, dual<S>>;
+  using transition_matrix = matrix<S, S>;
+  using observation_matrix = matrix<M, S>;
+  using measurement_vector = vector<M>;
+  using measurement_covariance_matrix = matrix<M, dual<M>>;
+  using gain_matrix = matrix<S, M>;
+private:
+  state_vector state_;
+  covariance_matrix covariance_;
+public:
+  multivariate_filter(const state_vector& initial, const covariance_matrix& covariance) :
+      state_(initial), covariance_(covariance)
+  {
+  }
+
+  [[nodiscard]] const state_vector& state() const { return state_; }
+  [[nodiscard]] const covariance_matrix& covariance() const { return covariance_; }
+
+  // state and covariance extrapolation
+  void predict(const transition_matrix& f, const covariance_matrix& process_noise)
+  {
+    state_ = f * state_;
+    covariance_ = f * covariance_ * transpose(f) + process_noise;
+  }
+
+  // state and covariance update with a new measurement
+  gain_matrix update(const measurement_vector& measured, const observation_matrix& h,
+                     const measurement_covariance_matrix& measurement_noise)
+  {
+    const auto h_t = transpose(h);
+    const gain_matrix gain = covariance_ * h_t * inverse(h * covariance_ * h_t + measurement_noise);
+    state_ = state_ + gain * (measured - h * state_);
+    covariance_ = (transition_matrix::identity() - gain * h) * covariance_;
+    return gain;
+  }
+};
+
+}  // namespace kalman
@@ -0,0 +1,152 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "kalman_eigen.h"
+#include <mp-units/ext/format.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#endif
+#include <Eigen/Core>
+#include <Eigen/LU>
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/math.h>
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+#endif
+
+// Tracking a drone in 3D with a constant-velocity model (6 states, 3 measured positions) using the
+// multivariate filter from `kalman_eigen.h`. The same filter is also implemented directly on raw
+// Eigen matrices to compare the run time of the unit-typed and the plain implementation.
+
+using namespace mp_units;
+
+template<typename F>
+double ns_per_step(int steps, F&& f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / steps;
+}
+
+int main()
+{
+  using namespace mp_units::si::unit_symbols;
+  constexpr auto pos = isq::displacement[m];
+  constexpr auto vel = isq::velocity[m / s];
+  using state_space = kalman::space<pos, pos, pos, vel, vel, vel>;
+  using measurement_space = kalman::space<pos, pos, pos>;
+  using filter = kalman::multivariate_filter<state_space, measurement_space>;
+
+  const quantity interval = isq::duration(0.1 * s);
+  const quantity position_error = isq::displacement(3. * m);
+  const quantity acceleration_noise = isq::acceleration(0.5 * m / s2);
+
+  // F = [I, Δt·I; 0, I]
+  filter::transition_matrix f = filter::transition_matrix::identity();
+  f.set<0, 3>(interval);
+  f.set<1, 4>(interval);
+  f.set<2, 5>(interval);
+
+  // H = [I, 0]
+  filter::observation_matrix h;
+  h.set<0, 0>(1. * one);
+  h.set<1, 1>(1. * one);
+  h.set<2, 2>(1. * one);
+
+  // R = σ²·I
+  filter::measurement_covariance_matrix r;
+  r.set<0, 0>(pow<2>(position_error));
+  r.set<1, 1>(pow<2>(position_error));
+  r.set<2, 2>(pow<2>(position_error));
+
+  // Q for a random (white noise) acceleration
+  filter::covariance_matrix q;
+  const quantity qa = pow<2>(acceleration_noise);
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    ((q.set<Is, Is>(qa * pow<4>(interval) / 4), q.set<Is, Is + 3>(qa * pow<3>(interval) / 2),
+      q.set<Is + 3, Is>(qa * pow<3>(interval) / 2), q.set<Is + 3, Is + 3>(qa * pow<2>(interval))),
+     ...);
+  }(std::make_index_sequence<3>{});
+
+  filter::covariance_matrix p0;
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    ((p0.set<Is, Is>(pow<2>(100. * m)), p0.set<Is + 3, Is + 3>(pow<2>(10. * m / s))), ...);
+  }(std::make_index_sequence<3>{});
+  const filter::state_vector x0{0. * m, 0. * m, 0. * m, 0. * m / s, 0. * m / s, 0. * m / s};
+
+  // simulated measurements of a drone flying with a constant velocity
+  constexpr int steps = 200'000;
+  std::mt19937 gen{42};
+  std::normal_distribution<double> noise{0., position_error.numerical_value_in(m)};
+  std::vector<filter::measurement_vector> measurements;
+  measurements.reserve(steps);
+  for (int i = 0; i < steps; ++i) {
+    const double t = (i + 1) * interval.numerical_value_in(s);
+    measurements.emplace_back(Eigen::Vector3d{12. * t + noise(gen), -4. * t + noise(gen), 2. * t + noise(gen)});
+  }
+
+  // unit-typed filter
+  filter typed{x0, p0};
+  const double typed_ns = ns_per_step(steps, [&] {
+    for (const auto& z : measurements) {
+      typed.predict(f, q);
+      (void)typed.update(z, h, r);
+    }
+  });
+
+  // the same filter on raw Eigen matrices
+  using mat6 = Eigen::Matrix<double, 6, 6>;
+  using mat3 = Eigen::Matrix<double, 3, 3>;
+  using mat63 = Eigen::Matrix<double, 6, 3>;
+  Eigen::Matrix<double, 6, 1> x = x0.values;
+  mat6 p = p0.values;
+  const mat6 fr = f.values, qr = q.values;
+  const Eigen::Matrix<double, 3, 6> hr = h.values;
+  const mat3 rr = r.values;
+  const double raw_ns = ns_per_step(steps, [&] {
+    for (const auto& z : measurements) {
+      x = fr * x;
+      p = fr * p * fr.transpose() + qr;
+      const mat3 s_inv = (hr * p * hr.transpose() + rr).inverse();
+      const mat63 k = p * hr.transpose() * s_inv;
+      x = x + k * (z.values - hr * x);
+      p = (mat6::Identity() - k * hr) * p;
+    }
+  });
+
+  std::cout << MP_UNITS_STD_FMT::format("Steps: {}\n", steps);
+  std::cout << MP_UNITS_STD_FMT::format("Unit-typed filter: {:.1f} ns/step\n", typed_ns);
+  std::cout << MP_UNITS_STD_FMT::format("Raw Eigen filter:  {:.1f} ns/step ({:.2f}x)\n", raw_ns, typed_ns / raw_ns);
+  std::cout << MP_UNITS_STD_FMT::format("Max state difference: {:.3e}\n",
+                                        (typed.state().values - x).cwiseAbs().maxCoeff());
+  std::cout << MP_UNITS_STD_FMT::format("Position: {::N[.2f]}, {::N[.2f]}, {::N[.2f]}\n", typed.state().get<0>(),
+                                        typed.state().get<1>(), typed.state().get<2>());
+  std::cout << MP_UNITS_STD_FMT::format("Speed: {::N[.2f]}\n", typed.state().segment<3, 3>().magnitude());
+  std::cout << MP_UNITS_STD_FMT::format("Position variance: {::N[.3f]}\n", typed.covariance().get<0, 0>());
+}
@@ -0,0 +1,120 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "kalman.h"
+#include <mp-units/ext/format.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si/unit_symbols.h>
+#endif
+
+// Tracking many vehicles at once with the α-β filter from example 2.
+// Compares a per-track loop over `system_state` objects with `kalman::batch_filter`.
+
+using namespace mp_units;
+
+constexpr std::size_t tracks = 100'000;
+constexpr std::size_t steps = 50;
+
+template<typename F>
+double tracks_per_second(F&& f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(tracks * steps) / elapsed.count();
+}
+
+int main()
+{
+  using namespace mp_units::si::unit_symbols;
+  using qp = quantity_point<isq::displacement[m]>;
+  using state = kalman::system_state<qp, quantity_point<isq::velocity[m / s]>>;
+  using estimate = kalman::system_state_estimate<qp, quantity_point<isq::velocity[m / s]>>;
+
+  const quantity interval = isq::duration(5. * s);
+  const std::array gain = {0.2 * one, 0.1 * one};
+
+  // every vehicle starts at a different position and moves with a different constant velocity;
+  // the radar measures the position with a normally distributed error
+  std::mt19937 gen{42};
+  std::uniform_real_distribution<double> start_position{0., 50'000.};
+  std::uniform_real_distribution<double> velocity{20., 60.};
+  std::normal_distribution<double> measurement_error{0., 100.};
+
+  std::vector<state> initial;
+  std::vector<quantity<isq::velocity[m / s]>> true_velocity;
+  initial.reserve(tracks);
+  true_velocity.reserve(tracks);
+  for (std::size_t i = 0; i < tracks; ++i) {
+    initial.emplace_back(qp{start_position(gen) * m}, quantity_point{40. * m / s});
+    true_velocity.push_back(velocity(gen) * m / s);
+  }
+
+  std::vector<std::vector<qp>> measurements(steps, std::vector<qp>(tracks));
+  for (std::size_t step = 0; step < steps; ++step)
+    for (std::size_t i = 0; i < tracks; ++i)
+      measurements[step][i] =
+        get<0>(initial[i]) + true_velocity[i] * (static_cast<double>(step + 1) * interval) + measurement_error(gen) * m;
+
+  // one `system_state` per track
+  std::vector<state> per_track = initial;
+  const double per_track_rate = tracks_per_second([&] {
+    for (std::size_t step = 0; step < steps; ++step)
+      for (std::size_t i = 0; i < tracks; ++i)
+        per_track[i] =
+          state_update(state_extrapolation(per_track[i], interval), measurements[step][i], gain, interval);
+  });
+
+  // all the tracks in one batch
+  kalman::batch_filter<qp, quantity_point<isq::velocity[m / s]>> batch;
+  batch.reserve(tracks);
+  for (const state& s : initial) batch.add_track(estimate{s, 0. * m});
+  const double batch_rate = tracks_per_second([&] {
+    for (std::size_t step = 0; step < steps; ++step) {
+      batch.state_extrapolation(interval);
+      batch.state_update(std::span<const qp>{measurements[step]}, gain, interval);
+    }
+  });
+
+  quantity<isq::displacement[m]> max_difference = 0. * m;
+  for (std::size_t i = 0; i < tracks; ++i)
+    max_difference = std::max(max_difference, abs(get<0>(batch.state(i)) - get<0>(per_track[i])));
+
+  std::cout << MP_UNITS_STD_FMT::format("Tracks: {}, steps: {}\n", tracks, steps);
+  std::cout << MP_UNITS_STD_FMT::format("Per-track loop: {:.3e} track updates/s\n", per_track_rate);
+  std::cout << MP_UNITS_STD_FMT::format("Batch filter:   {:.3e} track updates/s ({:.1f}x)\n", batch_rate,
+                                        batch_rate / per_track_rate);
+  std::cout << MP_UNITS_STD_FMT::format("Max position difference: {}\n", max_difference);
+  std::cout << MP_UNITS_STD_FMT::format("Track 0 estimate: {::0[:N[.2f]]1[:N[.2f]]}\n", batch.state(0));
+}
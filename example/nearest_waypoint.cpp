@@ -0,0 +1,151 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "geographic.h"
+#include "position_index.h"
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/format.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <execution>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#endif
+
+// Finds the nearest waypoints among a million ones with a `position_index` and compares it with a linear
+// scan over the batch `spherical_distance()`.
+
+namespace {
+
+using namespace geographic;
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+// uniformly distributed over the globe
+std::vector<position<double>> random_positions(std::size_t count, unsigned seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> z(-1., 1.);
+  std::uniform_real_distribution<double> lon(-180., 180.);
+  std::vector<position<double>> res;
+  res.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+    res.emplace_back(equator + std::asin(z(gen)) * 180 / std::numbers::pi * deg, prime_meridian + lon(gen) * deg);
+  return res;
+}
+
+template<typename F>
+std::chrono::duration<double, std::milli> measure(F&& f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::steady_clock::now() - start;
+}
+
+void example()
+{
+  constexpr std::size_t count = 1'000'000;
+  constexpr std::size_t query_count = 50;
+  constexpr std::size_t k = 8;
+  const quantity radius = 50. * isq::distance[km];
+
+  const auto waypoints = random_positions(count, 42);
+  const auto queries = random_positions(query_count, 7);
+
+  position_index<double> index;
+  const auto build_time = measure([&] { index = position_index<double>(std::span(waypoints)); });
+  const auto parallel_build_time =
+    measure([&] { index = position_index<double>(std::execution::par, std::span(waypoints)); });
+
+  std::cout << MP_UNITS_STD_FMT::format("Index of {} waypoints built in {:.1f} ms (parallel: {:.1f} ms)\n\n",
+                                        count, build_time.count(), parallel_build_time.count());
+
+  // the linear scan
+  const position_array<double> soa(waypoints);
+  std::vector<distance> distances(count);
+  std::vector<std::array<neighbour, k>> scan_results(query_count);
+  std::vector<std::size_t> scan_counts(query_count);
+  std::vector<std::size_t> order(count);
+  const auto scan_time = measure([&] {
+    for (std::size_t q = 0; q < query_count; ++q) {
+      spherical_distance(queries[q], soa, distances, great_circle_formula::haversine);
+      for (std::size_t i = 0; i < count; ++i) order[i] = i;
+      std::ranges::partial_sort(order, order.begin() + k, {}, [&](std::size_t i) { return distances[i]; });
+      for (std::size_t i = 0; i < k; ++i) scan_results[q][i] = {order[i], distances[order[i]]};
+      scan_counts[q] =
+        static_cast<std::size_t>(std::ranges::count_if(distances, [&](const distance& d) { return d <= radius; }));
+    }
+  });
+
+  // the index
+  std::vector<std::array<neighbour, k>> index_results(query_count);
+  std::vector<std::size_t> index_counts(query_count);
+  const auto index_time = measure([&] {
+    for (std::size_t q = 0; q < query_count; ++q) {
+      index.nearest(queries[q], index_results[q]);
+      index_counts[q] = index.count_within(queries[q], radius);
+    }
+  });
+
+  bool same = scan_counts == index_counts;
+  for (std::size_t q = 0; q < query_count; ++q)
+    for (std::size_t i = 0; i < k; ++i)
+      same = same && abs(scan_results[q][i].dist - index_results[q][i].dist) < 1. * isq::distance[m];
+
+  std::cout << MP_UNITS_STD_FMT::format("{} queries ({}-NN and count within {}):\n", query_count, k, radius);
+  std::cout << MP_UNITS_STD_FMT::format("- linear scan: {:>12.0f} queries/s\n",
+                                        query_count / std::chrono::duration<double>(scan_time).count());
+  std::cout << MP_UNITS_STD_FMT::format("- index:       {:>12.0f} queries/s (x{:.0f}, results {})\n\n",
+                                        query_count / std::chrono::duration<double>(index_time).count(),
+                                        scan_time / index_time, same ? "identical" : "DIFFERENT");
+
+  const neighbour nearest = *index.nearest(queries[0]);
+  std::cout << MP_UNITS_STD_FMT::format("The waypoint nearest to the first query point is #{}, {::N[.1f]} away\n",
+                                        nearest.index, nearest.dist);
+}
+
+}  // namespace
+
+int main()
+{
+  try {
+    example();
+  } catch (const std::exception& ex) {
+    std::cerr << "Unhandled std exception caught: " << ex.what() << '\n';
+  } catch (...) {
+    std::cerr << "Unhandled unknown exception caught\n";
+  }
+}
@@ -0,0 +1,180 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ode.h"
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/format.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <tuple>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/math.h>
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#endif
+
+// Integrates the discharge of a capacitor and the fall of a body with air drag with the unit-checked
+// `ode::rk4()` and `ode::rk45()` integrators, and compares their cost with a raw RK4 on doubles.
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+using time_type = quantity<isq::duration[s]>;
+
+constexpr time_type t0 = 0. * s;
+
+template<typename F>
+std::chrono::duration<double, std::milli> measure(F&& f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::steady_clock::now() - start;
+}
+
+void capacitor()
+{
+  const quantity C = isq::capacitance(0.47 * uF);
+  const quantity R = isq::resistance(4.7 * si::kilo<si::ohm>);
+  const quantity V0 = isq::voltage(5.0 * V);
+
+  // dV/dt = -V / (R C)
+  const auto discharge = [&](time_type, const ode::state<quantity<isq::voltage[V]>>& y) {
+    return std::tuple{-std::get<0>(y) / (R * C)};
+  };
+
+  const time_type t1 = 10. * ms;
+  const quantity exact = V0 * exp((-t1 / (R * C)).in(one));
+  const auto [rk4] = ode::rk4(discharge, t0, ode::state{V0}, t1, 20);
+  const auto rk45 = ode::rk45(discharge, t0, ode::state{V0}, t1, 0.1 * ms, 1e-9, ode::state{1e-12 * V});
+
+  std::cout << MP_UNITS_STD_FMT::format("Capacitor discharge after {} (exact: {::N[.9f]}):\n", t1.in(ms), exact);
+  std::cout << MP_UNITS_STD_FMT::format("- RK4, 20 steps:     {::N[.9f]} (error {::N[.1e]})\n", rk4,
+                                        abs(rk4 - exact));
+  std::cout << MP_UNITS_STD_FMT::format("- RK45, {:>2} steps:    {::N[.9f]} (error {::N[.1e]}, {} rejected)\n\n",
+                                        rk45.accepted, std::get<0>(rk45.y), abs(std::get<0>(rk45.y) - exact),
+                                        rk45.rejected);
+}
+
+// a sphere falling through the air with a quadratic drag
+constexpr double mass_kg = 0.145;
+constexpr double drag_per_kg = 0.5 * 1.225 * 0.47 * 0.0042 / mass_kg;  // ½ ρ C_d A / m [1/m]
+constexpr quantity g = (1. * si::standard_gravity).in(m / s2);            // not rescaled in every evaluation
+
+using fall_state = ode::state<quantity<isq::height[m]>, quantity<isq::speed[m / s]>>;
+
+const auto fall = [](time_type, const fall_state& y) {
+  const auto& [h, v] = y;
+  const quantity k = drag_per_kg / isq::height[m];
+  return std::tuple{-v, g - k * v * v};
+};
+
+// the same model hand-written on doubles (the speed is downwards)
+void raw_rk4(std::array<double, 2>& y, double h, std::size_t steps)
+{
+  const auto f = [](const std::array<double, 2>& s) {
+    return std::array{-s[1], g.numerical_value_in(m / s2) - drag_per_kg * s[1] * s[1]};
+  };
+  for (std::size_t i = 0; i < steps; ++i) {
+    const auto k1 = f(y);
+    const auto k2 = f({y[0] + h / 2 * k1[0], y[1] + h / 2 * k1[1]});
+    const auto k3 = f({y[0] + h / 2 * k2[0], y[1] + h / 2 * k2[1]});
+    const auto k4 = f({y[0] + h * k3[0], y[1] + h * k3[1]});
+    for (std::size_t j = 0; j < 2; ++j) y[j] += h / 6 * (k1[j] + 2 * k2[j] + 2 * k3[j] + k4[j]);
+  }
+}
+
+void falling_body()
+{
+  const quantity terminal_speed = sqrt(g * isq::height(1. * m) / drag_per_kg);
+  const auto res =
+    ode::rk45(fall, t0, fall_state{1000. * m, 0. * m / s}, 10. * s, 0.01 * s, 1e-9, fall_state{1e-6 * m, 1e-6 * m / s});
+  std::cout << MP_UNITS_STD_FMT::format("A ball dropped from 1000 m after {} ({} steps):\n", res.time, res.accepted);
+  std::cout << MP_UNITS_STD_FMT::format("- height: {::N[.2f]}\n", std::get<0>(res.y));
+  std::cout << MP_UNITS_STD_FMT::format("- speed:  {::N[.2f]} (terminal speed {::N[.2f]})\n\n", std::get<1>(res.y),
+                                        terminal_speed.in(m / s));
+
+  // many initial conditions
+  constexpr std::size_t count = 100'000;
+  constexpr std::size_t steps = 100;
+  const time_type t1 = 5. * s;
+  std::vector<fall_state> initial(count);
+  for (std::size_t i = 0; i < count; ++i)
+    initial[i] = fall_state{(100. + static_cast<double>(i % 1000)) * m, static_cast<double>(i % 30) * m / s};
+
+  std::vector<std::array<double, 2>> raw(count);
+  for (std::size_t i = 0; i < count; ++i)
+    raw[i] = {std::get<0>(initial[i]).numerical_value_in(m), std::get<1>(initial[i]).numerical_value_in(m / s)};
+  const auto raw_time = measure([&] {
+    for (auto& y : raw) raw_rk4(y, t1.numerical_value_in(s) / steps, steps);
+  });
+
+  std::vector<fall_state> scalar = initial;
+  const auto scalar_time = measure([&] {
+    for (auto& y : scalar) y = ode::rk4(fall, t0, y, t1, steps);
+  });
+
+  std::vector<fall_state> batch = initial;
+  const auto batch_time = measure([&] { ode::rk4(fall, t0, std::span(batch), t1, steps); });
+
+  double max_diff = 0;
+  for (std::size_t i = 0; i < count; ++i)
+    max_diff = std::max({max_diff, std::abs(std::get<0>(scalar[i]).numerical_value_in(m) - raw[i][0]),
+                         std::abs(std::get<0>(batch[i]).numerical_value_in(m) - raw[i][0])});
+
+  std::cout << MP_UNITS_STD_FMT::format("{} drops integrated over {} with {} RK4 steps each:\n", count, t1, steps);
+  std::cout << MP_UNITS_STD_FMT::format("- raw doubles:     {:>7.1f} ms\n", raw_time.count());
+  std::cout << MP_UNITS_STD_FMT::format("- ode::rk4:        {:>7.1f} ms\n", scalar_time.count());
+  std::cout << MP_UNITS_STD_FMT::format("- ode::rk4, batch: {:>7.1f} ms\n", batch_time.count());
+  std::cout << MP_UNITS_STD_FMT::format("The largest difference from the raw results is {:.1e} m\n", max_diff);
+}
+
+void example()
+{
+  capacitor();
+  falling_body();
+}
+
+}  // namespace
+
+int main()
+{
+  try {
+    example();
+  } catch (const std::exception& ex) {
+    std::cerr << "Unhandled std exception caught: " << ex.what() << '\n';
+  } catch (...) {
+    std::cerr << "Unhandled unknown exception caught\n";
+  }
+}
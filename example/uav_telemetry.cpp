@@ -0,0 +1,145 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "geographic.h"
+#include "time_series.h"
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/format.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <numbers>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#include <mp-units/systems/yard_pound.h>
+#endif
+
+// Streams the altitude and power telemetry of a fleet of UAVs through fixed-size `time_series` windows
+// and derives the climb rate and the consumed energy on the fly.
+
+namespace {
+
+using namespace geographic;
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+
+inline constexpr struct launch_site final : relative_point_origin<mean_sea_level + 350 * isq::altitude[m]> {
+} launch_site;
+
+using timestamp = quantity_point<isq::time[s], chrono_point_origin<std::chrono::steady_clock>>;
+using power_draw = quantity<isq::power[W]>;
+
+constexpr std::size_t window = 1000;  // 1 s at 1 kHz
+
+struct uav_telemetry {
+  time_series<msl_altitude, window> altitude;
+  time_series<power_draw, window> power;
+};
+
+// a steady climb with some turbulence and a constant electrical load with a periodic payload
+msl_altitude altitude_at(std::size_t uav, quantity<isq::time[s]> t)
+{
+  const double phase = static_cast<double>(uav);
+  return launch_site + (2. * isq::altitude[m] / s) * t +
+         0.5 * isq::altitude[m] * std::sin(2 * std::numbers::pi * t.numerical_value_in(s) + phase);
+}
+
+power_draw power_at(std::size_t uav, quantity<isq::time[s]> t)
+{
+  const double phase = static_cast<double>(uav);
+  return 300. * isq::power[W] + 50. * isq::power[W] * std::sin(2 * std::numbers::pi * t.numerical_value_in(s) + phase);
+}
+
+void example()
+{
+  constexpr std::size_t fleet_size = 64;
+  constexpr std::size_t sample_count = 10'000;  // 10 s at 1 kHz
+  const quantity period = 1. * isq::time[ms];
+
+  std::vector<uav_telemetry> fleet(fleet_size);
+  const timestamp start{std::chrono::steady_clock::now()};
+
+  const auto wall_start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < sample_count; ++i) {
+    const quantity t = static_cast<double>(i) * period;
+    for (std::size_t u = 0; u < fleet_size; ++u) {
+      fleet[u].altitude.push(start + t, altitude_at(u, t));
+      fleet[u].power.push(start + t, power_at(u, t));
+    }
+  }
+  const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wall_start;
+
+  std::cout << MP_UNITS_STD_FMT::format("Streamed {} samples of {} UAVs in {:.1f} ms ({:.0f} samples/s)\n",
+                                        2 * sample_count * fleet_size, fleet_size, wall.count() * 1e3,
+                                        2. * sample_count * fleet_size / wall.count());
+  std::cout << MP_UNITS_STD_FMT::format("Every stream keeps {} samples in {} bytes\n\n", window,
+                                        sizeof(fleet[0].altitude));
+
+  const uav_telemetry& uav = fleet[0];
+  const quantity flight_time = uav.altitude.newest().time - start;
+  const quantity expected_energy = 300. * isq::power[W] * flight_time;  // whole periods of the payload
+  std::cout << MP_UNITS_STD_FMT::format("UAV #0 after {::N[.3f]}:\n", flight_time);
+  std::cout << MP_UNITS_STD_FMT::format("- altitude:         {::N[.2f]} AMSL\n",
+                                        uav.altitude.newest().value - mean_sea_level);
+  std::cout << MP_UNITS_STD_FMT::format("- climb rate:       {::N[.2f]} (over the last {::N[.3f]}: {::N[.3f]})\n",
+                                        uav.altitude.rate().in(m / s), uav.altitude.window_duration(),
+                                        uav.altitude.mean_rate().in(m / s));
+  std::cout << MP_UNITS_STD_FMT::format("- energy consumed:  {::N[.1f]} (expected ~{::N[.1f]})\n",
+                                        uav.power.integral().in(J), expected_energy.in(J));
+  std::cout << MP_UNITS_STD_FMT::format("- last second:      {::N[.1f]}, mean power {::N[.1f]}\n\n",
+                                        uav.power.window_integral().in(J),
+                                        (uav.power.window_integral() / uav.power.window_duration()).in(W));
+
+  // the window re-expressed without copying it
+  std::cout << "The last 5 altitude samples of UAV #0:\n";
+  std::cout << "      AMSL [m]   above launch [ft]\n";
+  auto amsl = uav.altitude.values_in(m);
+  auto above_launch = uav.altitude.values_for(launch_site);
+  for (std::size_t i = uav.altitude.size() - 5; i < uav.altitude.size(); ++i)
+    std::cout << MP_UNITS_STD_FMT::format(
+      "  {:>12.3f}   {:>17.3f}\n",
+      amsl[static_cast<std::ptrdiff_t>(i)].quantity_from(mean_sea_level).numerical_value_in(m),
+      above_launch[static_cast<std::ptrdiff_t>(i)].quantity_from(launch_site).numerical_value_in(yard_pound::foot));
+}
+
+}  // namespace
+
+int main()
+{
+  try {
+    example();
+  } catch (const std::exception& ex) {
+    std::cerr << "Unhandled std exception caught: " << ex.what() << '\n';
+  } catch (...) {
+    std::cerr << "Unhandled unknown exception caught\n";
+  }
+}
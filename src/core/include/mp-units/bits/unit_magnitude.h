@@ -24,6 +24,7 @@
 
 // IWYU pragma: private, include <mp-units/framework.h>
 #include <mp-units/bits/constexpr_math.h>
+#include <mp-units/bits/fixed_point.h>
 #include <mp-units/bits/hacks.h>
 #include <mp-units/bits/module_macros.h>
 #include <mp-units/bits/ratio.h>
@@ -140,8 +141,9 @@ template<typename M>
 }
 
 // `widen_t` gives the widest arithmetic type in the same category, for intermediate computations.
+// Integers wider than `std::intmax_t` (e.g. `__int128` in GNU mode) are already the widest ones.
 template<typename T>
-using widen_t = conditional<std::is_arithmetic_v<T>,
+using widen_t = conditional<std::is_arithmetic_v<T> && (sizeof(T) <= sizeof(std::intmax_t)),
                             conditional<std::is_floating_point_v<T>, long double,
                                         conditional<std::is_signed_v<T>, std::intmax_t, std::uintmax_t>>,
                             T>;
@@ -503,10 +505,10 @@ private:
    *
    * Useful for overflow-detection in concepts and constraints, where a hard abort would
    * prevent the expression from being softly evaluated in a `requires` clause.
-   * Only available for unsigned integral T.
+   * Only available for unsigned integral T (including `uint128_t`).
    */
   template<typename T>
-    requires std::is_unsigned_v<T> && ((is_integral_impl(Ms) && ...))
+    requires(std::is_unsigned_v<T> || is_same_v<T, uint128_t>) && ((is_integral_impl(Ms) && ...))
   [[nodiscard]] friend consteval std::optional<T> try_get_value(const unit_magnitude&)
   {
     std::optional<T> result{T{1}};
@@ -521,7 +523,7 @@ private:
     requires((is_integral_impl(Ms) && ...)) || treat_as_floating_point<T>
   [[nodiscard]] friend consteval T get_value(const unit_magnitude&)
   {
-    if constexpr (std::is_unsigned_v<T>) {
+    if constexpr (std::is_unsigned_v<T> || is_same_v<T, uint128_t>) {
       constexpr auto result = try_get_value<T>(unit_magnitude{});
       static_assert(result.has_value(), "Magnitude value overflows the target unsigned type");
       return *result;
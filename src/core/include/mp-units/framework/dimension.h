@@ -43,6 +43,7 @@
 #ifdef MP_UNITS_IMPORT_STD
 import std;
 #else
+#include <array>
 #include <cstdint>
 #include <iterator>
 #include <string_view>
@@ -300,6 +301,20 @@ MP_UNITS_EXPORT template<dimension_symbol_formatting fmt, typename CharT, Dimens
 template<dimension_symbol_formatting fmt, typename CharT, Dimension D>
 constexpr auto dimension_symbol_result = dimension_symbol_impl<fmt, CharT>(D{});
 
+[[nodiscard]] consteval dimension_symbol_formatting dimension_symbol_formatting_for(character_set char_set)
+{
+  dimension_symbol_formatting fmt{};
+  fmt.char_set = char_set;
+  return fmt;
+}
+
+// Symbols of `D` precomputed for every formatting variant (indexed with `character_set`),
+// so runtime-selected formatting costs a table lookup instead of a symbol rebuild
+template<typename CharT, Dimension D>
+constexpr std::array<std::basic_string_view<CharT>, 2> dimension_symbol_variants = {
+  dimension_symbol_result<dimension_symbol_formatting_for(character_set::utf8), CharT, D>.view(),
+  dimension_symbol_result<dimension_symbol_formatting_for(character_set::portable), CharT, D>.view()};
+
 }  // namespace detail
 
 // TODO Refactor to `dimension_symbol(D, fmt)` when P1045: constexpr Function Parameters is available
@@ -372,18 +387,16 @@ public:
   }
 
   template<typename FormatContext>
-  constexpr auto format(const D& d, FormatContext& ctx) const -> decltype(ctx.out())
+  constexpr auto format(const D&, FormatContext& ctx) const -> decltype(ctx.out())
   {
     auto specs = specs_;
     mp_units::detail::handle_dynamic_spec<mp_units::detail::width_checker>(specs.width, specs.width_ref, ctx);
 
-    // Use a fixed-size stack buffer so that dimension_symbol_to is always instantiated
-    // with Char* regardless of the FormatContext iterator type. This collapses all
-    // call-site instantiations of dimension_symbol_impl to a single one (Char*).
-    Char buf[128];
-    const Char* const end = mp_units::dimension_symbol_to<Char>(buf, d, specs);
-    return mp_units::detail::write_padded<Char>(ctx.out(), std::basic_string_view<Char>{buf, end}, specs.width,
-                                                specs.align, specs.fill);
+    // All the formatting variants of the symbol are generated at compile time, so the runtime
+    // modifiers only select an entry of the table
+    const std::basic_string_view<Char> symbol =
+      mp_units::detail::dimension_symbol_variants<Char, D>[specs.char_set == mp_units::character_set::utf8 ? 0 : 1];
+    return mp_units::detail::write_padded<Char>(ctx.out(), symbol, specs.width, specs.align, specs.fill);
   }
 };
 
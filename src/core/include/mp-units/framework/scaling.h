@@ -31,6 +31,7 @@
 import std;
 #else
 #include <concepts>
+#include <limits>
 #endif
 #endif
 
@@ -96,6 +97,13 @@ constexpr decltype(auto) as_element(const T& value)
     return value;
 }
 
+template<typename T, UnitMagnitude M>
+[[nodiscard]] consteval bool fits_in(M m)
+{
+  const auto value = try_get_value<uint128_t>(m);
+  return value.has_value() && *value <= static_cast<uint128_t>(std::numeric_limits<T>::max());
+}
+
 template<auto M, typename T>
 [[nodiscard]] constexpr auto scale_int(const T& v)
 {
@@ -114,8 +122,12 @@ template<auto M, typename T>
     // The wider type propagates through the type's own operators:
     // plain int widens via C++ promotion rules, safe_int widens via its
     // checked operator* template, cartesian_vector widens element-wise, etc.
+    // The denominator is a wider_t too when it does not fit in element_t (e.g. the 70+ bit
+    // denominators of conversions between the US survey and the astronomical units), so that
+    // such conversions stay an exact integer multiply/divide pair.
     constexpr wider_t num = get_value<wider_t>(numerator(M));
-    constexpr element_t den = get_value<element_t>(denominator(M));
+    using den_t = conditional<fits_in<element_t>(denominator(M)), element_t, wider_t>;
+    constexpr den_t den = get_value<den_t>(denominator(M));
     return v * num / den;
   } else {
     // M has irrational factors (e.g. π): use long double fixed-point approximation.
@@ -55,6 +55,7 @@ import std;
 #include <iterator>
 #include <string_view>
 #include <tuple>
+#include <utility>
 #if MP_UNITS_HOSTED
 #include <string>
 #endif
@@ -947,6 +948,45 @@ MP_UNITS_EXPORT template<unit_symbol_formatting fmt, typename CharT, Unit U>
 template<unit_symbol_formatting fmt, typename CharT, Unit U>
 constexpr auto unit_symbol_result = unit_symbol_impl<fmt, CharT>(U{});
 
+// every valid combination of `character_set`, `unit_symbol_solidus`, and `unit_symbol_separator`
+// (`unit_symbol_separator::half_high_dot` requires `character_set::utf8`)
+inline constexpr std::size_t unit_symbol_formatting_variants = 3 * 2 + 3;
+
+[[nodiscard]] constexpr std::size_t unit_symbol_formatting_index(const unit_symbol_formatting& fmt)
+{
+  const auto solidus = static_cast<std::size_t>(fmt.solidus);
+  if (fmt.char_set == character_set::utf8) return solidus * 2 + static_cast<std::size_t>(fmt.separator);
+  return 3 * 2 + solidus;
+}
+
+[[nodiscard]] consteval unit_symbol_formatting unit_symbol_formatting_at(std::size_t index)
+{
+  unit_symbol_formatting fmt{};
+  if (index < 3 * 2) {
+    fmt.char_set = character_set::utf8;
+    fmt.solidus = static_cast<unit_symbol_solidus>(index / 2);
+    fmt.separator = static_cast<unit_symbol_separator>(index % 2);
+  } else {
+    fmt.char_set = character_set::portable;
+    fmt.solidus = static_cast<unit_symbol_solidus>(index - 3 * 2);
+    fmt.separator = unit_symbol_separator::space;
+  }
+  return fmt;
+}
+
+template<typename CharT, Unit U, std::size_t... Is>
+[[nodiscard]] consteval std::array<std::basic_string_view<CharT>, sizeof...(Is)> unit_symbol_variants_impl(
+  std::index_sequence<Is...>)
+{
+  return {unit_symbol_result<unit_symbol_formatting_at(Is), CharT, U>.view()...};
+}
+
+// Symbols of `U` precomputed for every formatting variant (indexed with `unit_symbol_formatting_index`),
+// so runtime-selected formatting costs a table lookup instead of a symbol rebuild
+template<typename CharT, Unit U>
+constexpr auto unit_symbol_variants =
+  unit_symbol_variants_impl<CharT, U>(std::make_index_sequence<unit_symbol_formatting_variants>{});
+
 }  // namespace detail
 
 // TODO Refactor to `unit_symbol(U, fmt)` when P1045: constexpr Function Parameters is available
@@ -1041,18 +1081,16 @@ public:
   }
 
   template<typename FormatContext>
-  constexpr auto format(const U& u, FormatContext& ctx) const -> decltype(ctx.out())
+  constexpr auto format(const U&, FormatContext& ctx) const -> decltype(ctx.out())
   {
     auto specs = specs_;
     mp_units::detail::handle_dynamic_spec<mp_units::detail::width_checker>(specs.width, specs.width_ref, ctx);
 
-    // Use a fixed-size stack buffer so that unit_symbol_to is always instantiated
-    // with Char* regardless of the FormatContext iterator type. This collapses all
-    // call-site instantiations of unit_symbol_impl to a single one (Char*).
-    Char buf[128];
-    const Char* const end = mp_units::unit_symbol_to<Char>(buf, u, specs);
-    return mp_units::detail::write_padded<Char>(ctx.out(), std::basic_string_view<Char>{buf, end}, specs.width,
-                                                specs.align, specs.fill);
+    // All the formatting variants of the symbol are generated at compile time, so the runtime
+    // modifiers only select an entry of the table
+    const std::basic_string_view<Char> symbol =
+      mp_units::detail::unit_symbol_variants<Char, U>[mp_units::detail::unit_symbol_formatting_index(specs)];
+    return mp_units::detail::write_padded<Char>(ctx.out(), symbol, specs.width, specs.align, specs.fill);
   }
 };
 
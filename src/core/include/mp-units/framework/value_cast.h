@@ -44,14 +44,21 @@ template<typename Rep, Unit UFrom, Unit UTo>
     return false;
   else if constexpr (std::totally_ordered_with<Rep, std::uintmax_t> &&
                      requires(Rep v) { representation_values<Rep>::max(); }) {
+    // The factor is evaluated in 128 bits, so that rational factors between e.g. the US survey and the
+    // astronomical units, whose numerators do not fit in 64 bits, are still checked (and scaled) exactly.
     const auto factor =
-      try_get_value<std::uintmax_t>(numerator(get_canonical_unit(UFrom{}).mag / get_canonical_unit(UTo{}).mag));
+      try_get_value<uint128_t>(numerator(get_canonical_unit(UFrom{}).mag / get_canonical_unit(UTo{}).mag));
     if (!factor.has_value())
-      return true;  // factor overflows uintmax_t => certainly overflows Rep too
-    else if constexpr (std::is_integral_v<Rep>)
-      return !std::in_range<Rep>(*factor);
+      return true;  // factor overflows uint128_t => certainly overflows Rep too
+    else if (*factor > std::numeric_limits<std::uintmax_t>::max()) {
+      if constexpr (sizeof(Rep) > sizeof(std::uintmax_t) && std::totally_ordered_with<Rep, uint128_t>)
+        return *factor > static_cast<uint128_t>(representation_values<Rep>::max());
+      else
+        return true;  // Rep is not wider than uintmax_t
+    } else if constexpr (std::is_integral_v<Rep>)
+      return !std::in_range<Rep>(static_cast<std::uintmax_t>(*factor));
     else
-      return *factor > representation_values<Rep>::max();
+      return static_cast<std::uintmax_t>(*factor) > representation_values<Rep>::max();
   } else
     // if the representation is not totally ordered with std::uintmax_t or does not have max() defined
     // then we assume that it might store any value
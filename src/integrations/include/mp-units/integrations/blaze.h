@@ -27,6 +27,8 @@
 //
 // What Blaze already provides out of the box:
 //   - free `norm()` -> the `magnitude()` CPO uses it (via ADL) for the Euclidean magnitude
+//   - `operator==` and `operator()` for the sparse `CompressedMatrix`/`CompressedVector` as well, so
+//     they are representation types (e.g. of a stiffness matrix) with no further adaptation
 // What this header adds:
 //   - `representation_underlying_type` from Blaze's `ElementType` (Blaze does not expose the
 //     `value_type`/`element_type` names the library detects automatically)
@@ -36,6 +38,9 @@
 //     every unknown type as a scalar, so without this its greedy `vector * scalar` operator would
 //     match the `value * unit_magnitude` probe and hard-error deep inside `MultTrait`
 //
+// To evaluate a whole expression in one fused loop instead (e.g. `a * lazy(x) + b * lazy(y)`), wrap
+// the operand quantities with `lazy()` (see `mp-units/integrations/lazy_quantity.h`, included here).
+//
 // The whole header is inert unless Blaze is actually available, so it is always safe to include.
 //
 // The header is dual-mode: included textually for header-mode consumers, and pulled into the
@@ -47,6 +52,8 @@
 #if __has_include(<blaze/math/StaticVector.h>)
 
 #ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/CompressedVector.h>
 #include <blaze/math/DynamicMatrix.h>
 #include <blaze/math/DynamicVector.h>
 #include <blaze/math/StaticMatrix.h>
@@ -63,6 +70,8 @@ import std;
 #include <type_traits>
 #endif
 #endif
+// outside of the guard above, so that `lazy()` is part of the module interface as well
+#include <mp-units/integrations/lazy_quantity.h>
 
 namespace mp_units {
 
@@ -33,19 +33,34 @@
 //   - `representation_canonical_type` for every Eigen expression, mapping it to the evaluated
 //     `PlainObject` so a `quantity` never stores a lazy expression template (which would hold
 //     dangling references to its operands).
+//   - `operator==` for sparse matrices and vectors (Eigen only defines it for dense objects), so
+//     `Eigen::SparseMatrix` is a regular representation type as well, e.g. of a stiffness matrix.
+//   - `solve()`, which runs an Eigen linear solver (e.g. `Eigen::ConjugateGradient` or
+//     `Eigen::BiCGSTAB`) on a matrix quantity and a right-hand side quantity and returns the
+//     solution with its unit.
+//
+// To evaluate a whole expression in one fused loop instead (e.g. `a * lazy(x) + b * lazy(y)`), wrap
+// the operand quantities with `lazy()` (see `mp-units/integrations/lazy_quantity.h`, included here).
 //
 // The whole header is inert unless Eigen is actually available, so it is always safe to include.
 //
 // The header is dual-mode: included textually for header-mode consumers, and pulled into the
-// `mp_units.integrations.eigen` module interface unit otherwise. In module mode, `<Eigen/Core>`
-// lives in the module's global module fragment and the customization points come from
-// `import mp_units.core`, so neither is included from the module purview here.
+// `mp_units.integrations.eigen` module interface unit otherwise. In module mode, `<Eigen/Core>` and
+// `<Eigen/SparseCore>` live in the module's global module fragment and the customization points come from
+// `import mp_units.core`, so neither is included from the module purview here. The sparse
+// `operator==` and `solve()` are exported so that importers (and the library's concepts, via ADL)
+// find them across the module boundary.
 
 #if __has_include(<Eigen/Core>)
 
+#include <mp-units/bits/module_macros.h>
+
 #ifndef MP_UNITS_IN_MODULE_INTERFACE
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 #include <mp-units/framework/customization_points.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/reference.h>
 #ifdef MP_UNITS_IMPORT_STD
 import std;
 #else
@@ -55,47 +70,198 @@ import std;
 #include <utility>
 #endif
 #endif
+// outside of the guard above, so that `lazy()` is part of the module interface as well
+#include <mp-units/integrations/lazy_quantity.h>
 
 namespace mp_units {
 
+namespace detail {
+
+// An Eigen dense or sparse object (a concrete matrix/vector or an expression). The
+// `typename T::PlainObject` requirement is checked first and short-circuits the rest of the
+// constraint: the traits below are instantiated for every representation type (including `int`,
+// `double`, ...), and `Eigen::EigenBase<T>` is ill-formed for a non-Eigen `T`, so it must not be
+// instantiated unless `T` already looks like an Eigen type.
+template<typename T>
+concept eigen_type = requires { typename T::PlainObject; } && std::derived_from<T, Eigen::EigenBase<T>>;
+
+template<typename T>
+concept eigen_sparse = eigen_type<T> && std::derived_from<T, Eigen::SparseMatrixBase<T>>;
+
+// The evaluated type of a sparse expression. Eigen's `PlainObject` is always a `SparseMatrix`, even
+// for a vector expression, and an expression involving a dense constant (e.g. a scaled matrix)
+// promotes its index type to `Eigen::Index`, so `2 * k` would not have the type of `k`. Use a
+// `SparseVector` for a vector expression and the default index type of the concrete types instead.
+template<typename T>
+[[nodiscard]] consteval auto eigen_sparse_plain_object()
+{
+  using scalar = T::Scalar;
+  using storage_index = Eigen::SparseMatrix<scalar>::StorageIndex;
+  if constexpr (T::ColsAtCompileTime == 1)
+    return std::type_identity<Eigen::SparseVector<scalar, Eigen::ColMajor, storage_index>>{};
+  else if constexpr (T::RowsAtCompileTime == 1)
+    return std::type_identity<Eigen::SparseVector<scalar, Eigen::RowMajor, storage_index>>{};
+  else
+    return std::type_identity<
+      Eigen::SparseMatrix<scalar, T::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor, storage_index>>{};
+}
+
+}  // namespace detail
+
 // Eigen arithmetic operators return lazy expression templates; store their evaluated concrete
 // type (`PlainObject`) in a quantity instead. Concrete matrices/vectors map to themselves.
-//
-// The `typename T::PlainObject` requirement is checked first and short-circuits the rest of the
-// constraint: `representation_canonical_type` is instantiated for every representation type
-// (including `int`, `double`, ...), and `Eigen::EigenBase<T>` is ill-formed for a non-Eigen `T`,
-// so it must not be instantiated unless `T` already looks like an Eigen type.
-template<typename T>
-  requires requires { typename T::PlainObject; } && std::derived_from<T, Eigen::EigenBase<T>>
+template<detail::eigen_type T>
 struct representation_canonical_type<T> {
   using type = std::remove_cvref_t<typename T::PlainObject>;
 };
 
+template<detail::eigen_sparse T>
+struct representation_canonical_type<T> {
+  using type = decltype(detail::eigen_sparse_plain_object<T>())::type;
+};
+
+template<typename Scalar, int Options, typename StorageIndex>
+struct representation_canonical_type<Eigen::SparseMatrix<Scalar, Options, StorageIndex>> {
+  using type = Eigen::SparseMatrix<Scalar, Options, StorageIndex>;
+};
+
+template<typename Scalar, int Options, typename StorageIndex>
+struct representation_canonical_type<Eigen::SparseVector<Scalar, Options, StorageIndex>> {
+  using type = Eigen::SparseVector<Scalar, Options, StorageIndex>;
+};
+
 // Eigen reports its shape at compile time, so the tensor order is read from `RowsAtCompileTime` /
 // `ColsAtCompileTime` rather than from structural detection: an Eigen column vector is an N×1 matrix
 // whose two-index `operator()` would otherwise make it look like an order-2 tensor. A row or column
 // (one dimension fixed to 1) is order 1; anything else is an order-2 matrix.
-template<typename T>
-  requires requires { typename T::PlainObject; } && std::derived_from<T, Eigen::EigenBase<T>>
+template<detail::eigen_type T>
 constexpr std::size_t tensor_order<T> = (T::RowsAtCompileTime == 1 || T::ColsAtCompileTime == 1) ? 1 : 2;
 
+// Eigen's sparse types expose neither indexing shape (only `coeff()`/`coeffRef()`), so the library
+// cannot detect their order and field structurally. These specializations of the concrete types are
+// more specialized than both the structural detection and the shape-based one above.
+template<typename Scalar, int Options, typename StorageIndex>
+constexpr std::size_t tensor_order<Eigen::SparseMatrix<Scalar, Options, StorageIndex>> = 2;
+
+template<typename Scalar, int Options, typename StorageIndex>
+constexpr std::size_t tensor_order<Eigen::SparseVector<Scalar, Options, StorageIndex>> = 1;
+
+template<typename Scalar, int Options, typename StorageIndex>
+constexpr quantity_field numeric_field<Eigen::SparseMatrix<Scalar, Options, StorageIndex>> = numeric_field<Scalar>;
+
+template<typename Scalar, int Options, typename StorageIndex>
+constexpr quantity_field numeric_field<Eigen::SparseVector<Scalar, Options, StorageIndex>> = numeric_field<Scalar>;
+
 namespace detail {
 
 // A fixed-size Eigen vector (a row or column whose length is known at compile time). This is the
 // shape the tuple protocol below is defined for: `std::tuple_size` needs a compile-time size, so
 // dynamic-size vectors (`SizeAtCompileTime == Eigen::Dynamic`) are deliberately excluded, and a
-// two-dimensional matrix is not a vector. The `typename T::PlainObject` probe is checked first and
-// short-circuits the rest, because the concept is evaluated for arbitrary representation types
-// (`int`, `double`, ...) for which `Eigen::EigenBase<T>` would be ill-formed.
+// two-dimensional matrix is not a vector. The `eigen_type` probe is checked first and short-circuits
+// the rest, because the concept is evaluated for arbitrary representation types (`int`, `double`,
+// ...) for which the compile-time extents do not exist.
 template<typename T>
-concept eigen_fixed_vector = requires { typename T::PlainObject; } && std::derived_from<T, Eigen::EigenBase<T>> &&
-                             (T::SizeAtCompileTime != Eigen::Dynamic) && (T::SizeAtCompileTime >= 1) &&
-                             (T::RowsAtCompileTime == 1 || T::ColsAtCompileTime == 1);
+concept eigen_fixed_vector = eigen_type<T> && (T::SizeAtCompileTime != Eigen::Dynamic) &&
+                             (T::SizeAtCompileTime >= 1) && (T::RowsAtCompileTime == 1 || T::ColsAtCompileTime == 1);
+
+// A sparse matrix or vector in column-major storage with the given scalar type, without a copy when
+// it already is one.
+template<typename Scalar, typename T>
+[[nodiscard]] decltype(auto) as_column_major(const Eigen::SparseMatrixBase<T>& m)
+{
+  using matrix = Eigen::SparseMatrix<Scalar, Eigen::ColMajor, typename T::StorageIndex>;
+  if constexpr (std::is_same_v<T, matrix>)
+    return static_cast<const matrix&>(m.derived());
+  else
+    return matrix(m.derived().template cast<Scalar>());
+}
 
 }  // namespace detail
 
+/**
+ * @brief Solves `A x = b` for the quantity `x` with an Eigen linear solver.
+ *
+ * The solver works on the numerical values of `a` and `b` in place (an iterative solver keeps only a
+ * reference to the matrix, so a sparse matrix is never copied), and the solution gets the reference
+ * `RB / RA`, e.g. a displacement for a stiffness matrix and a force. The solver's `info()`,
+ * `iterations()`, and `error()` stay available to the caller after the call.
+ *
+ * @param solver  an Eigen solver, e.g. `Eigen::ConjugateGradient` or `Eigen::BiCGSTAB`
+ * @param a       the matrix quantity
+ * @param b       the right-hand side
+ */
+MP_UNITS_EXPORT template<typename Solver, auto RA, typename MatA, auto RB, typename VecB>
+  requires requires(Solver& solver, const MatA& a, const VecB& b) {
+    solver.compute(a);
+    { solver.solve(b) } -> std::convertible_to<typename VecB::PlainObject>;
+  }
+[[nodiscard]] quantity<RB / RA, typename VecB::PlainObject> solve(Solver& solver, const quantity<RA, MatA>& a,
+                                                                  const quantity<RB, VecB>& b)
+{
+  solver.compute(a.numerical_value_ref_in(a.unit));
+  return quantity<RB / RA, typename VecB::PlainObject>(
+    typename VecB::PlainObject(solver.solve(b.numerical_value_ref_in(b.unit))), RB / RA);
+}
+
+/**
+ * @brief Solves `A x = b` for the quantity `x` with an iterative Eigen solver, starting from `guess`.
+ *
+ * @param guess  the initial solution; it must be implicitly convertible to the reference `RB / RA`
+ */
+MP_UNITS_EXPORT template<typename Solver, auto RA, typename MatA, auto RB, typename VecB, auto RX, typename VecX>
+  requires std::convertible_to<quantity<RX, VecX>, quantity<RB / RA, typename VecB::PlainObject>> &&
+           requires(Solver& solver, const MatA& a, const VecB& b, const VecB::PlainObject& x) {
+             solver.compute(a);
+             { solver.solveWithGuess(b, x) } -> std::convertible_to<typename VecB::PlainObject>;
+           }
+[[nodiscard]] quantity<RB / RA, typename VecB::PlainObject> solve(Solver& solver, const quantity<RA, MatA>& a,
+                                                                  const quantity<RB, VecB>& b,
+                                                                  const quantity<RX, VecX>& guess)
+{
+  using result = quantity<RB / RA, typename VecB::PlainObject>;
+  const result x0 = guess;
+  solver.compute(a.numerical_value_ref_in(a.unit));
+  return result(typename VecB::PlainObject(
+                  solver.solveWithGuess(b.numerical_value_ref_in(b.unit), x0.numerical_value_ref_in(result::unit))),
+                result::reference);
+}
+
 }  // namespace mp_units
 
+// Eigen defines `operator==` for dense objects only, so without this a sparse matrix would not be
+// `std::equality_comparable` and thus not a representation type. Two sparse objects are equal when
+// they have the same shape and the same coefficients; an explicitly stored zero equals a missing one.
+namespace Eigen {
+
+MP_UNITS_EXPORT template<typename Lhs, typename Rhs>
+[[nodiscard]] bool operator==(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs)
+{
+  if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) return false;
+  using scalar = typename ScalarBinaryOpTraits<typename Lhs::Scalar, typename Rhs::Scalar>::ReturnType;
+  const auto& l = mp_units::detail::as_column_major<scalar>(lhs);
+  const auto& r = mp_units::detail::as_column_major<scalar>(rhs);
+  for (Index k = 0; k < l.outerSize(); ++k) {
+    typename std::remove_cvref_t<decltype(l)>::InnerIterator i(l, k);
+    typename std::remove_cvref_t<decltype(r)>::InnerIterator j(r, k);
+    while (i || j) {
+      if (i && (!j || i.index() < j.index())) {
+        if (i.value() != scalar{}) return false;
+        ++i;
+      } else if (j && (!i || j.index() < i.index())) {
+        if (j.value() != scalar{}) return false;
+        ++j;
+      } else {
+        if (i.value() != j.value()) return false;
+        ++i;
+        ++j;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace Eigen
+
 // Tuple protocol for fixed-size Eigen vectors: makes them structured-bindings friendly
 // (`auto [x, y, z] = vec;`) and, lets `mp_units::utility`'s `polar_vector`/`spherical_vector`
 // read a vector representation's dimension via `std::tuple_size` and its components via `get`.
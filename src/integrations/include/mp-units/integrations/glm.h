@@ -31,12 +31,25 @@
 // missing is the Euclidean magnitude: GLM spells it `glm::length()` rather than `norm()`, so this
 // header adds a `magnitude()` overload (found by ADL) that the library's `magnitude()` CPO picks up.
 //
+// It also provides unit-checked batch transforms for spans of 3D GLM-vector quantities, e.g. vertex
+// buffers of `quantity_point<isq::position_vector[m], ..., glm::dvec3>`:
+//   - `rotate(r, from, to)` applies a `glm::mat3` to displacements or to points (about their origin),
+//   - `translate(offset, from, to)` adds a displacement to points,
+//   - `transform(pose, unit, from, to)` applies a `glm::mat4` pose whose translation is expressed in
+//     `unit`; points get the affine transform (`w = 1`) and displacements only its linear part (`w = 0`),
+//   - `project(proj, unit, from, ndc)` maps points to normalized device coordinates.
+// The unit conversions between the input, the matrix, and the output are folded into the matrix once
+// per batch, so the loop body is the same `mat * vec` as with raw GLM. The helpers are templated on
+// the GLM qualifier, so aligned types (`glm::aligned_dvec3`, with `GLM_FORCE_INTRINSICS`) keep using
+// GLM's SIMD implementation.
+//
 // The whole header is inert unless GLM is actually available, so it is always safe to include.
 //
 // The header is dual-mode: included textually for header-mode consumers, and pulled into the
 // `mp_units.integrations.glm` module interface unit otherwise. The `magnitude()` overload is
 // exported so that the `magnitude()` CPO can find it by ADL across the module boundary; in module
-// mode the GLM headers live in the module's global module fragment, so they are not included here.
+// mode the GLM headers live in the module's global module fragment and the library comes from
+// `import mp_units.core`, so neither is included here.
 
 #if __has_include(<glm/geometric.hpp>)
 
@@ -44,9 +57,23 @@
 
 #ifndef MP_UNITS_IN_MODULE_INTERFACE
 #include <glm/geometric.hpp>  // glm::length
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/quantity_point.h>
+#include <mp-units/framework/unit.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <concepts>
+#include <cstddef>
+#include <span>
+#endif
 #endif
 
 namespace glm {
@@ -59,4 +86,137 @@ MP_UNITS_EXPORT template<length_t L, typename T, qualifier Q>
 
 }  // namespace glm
 
+namespace mp_units {
+
+namespace detail {
+
+// A quantity (a displacement) or a quantity point (a position) represented by `glm::vec<3, T, Q>`.
+template<typename V, typename T, glm::qualifier Q>
+concept GlmVec3Quantity = Quantity<V> && std::same_as<typename V::rep, glm::vec<3, T, Q>>;
+
+template<typename V, typename T, glm::qualifier Q>
+concept GlmVec3QuantityPoint = QuantityPoint<V> && std::same_as<typename V::rep, glm::vec<3, T, Q>>;
+
+// Both a displacement or both a position (measured from the same origin), with an implicit conversion
+// between the two.
+template<typename From, typename To, typename T, glm::qualifier Q>
+concept GlmVec3BatchOf =
+  ((GlmVec3Quantity<From, T, Q> && GlmVec3Quantity<To, T, Q>) ||
+   (GlmVec3QuantityPoint<From, T, Q> && GlmVec3QuantityPoint<To, T, Q> && From::point_origin == To::point_origin)) &&
+  std::convertible_to<From, To>;
+
+template<Unit auto From, Unit auto To, typename T>
+constexpr T glm_unit_factor = get_value<T>(get_canonical_unit(From).mag / get_canonical_unit(To).mag);
+
+// The numerical value of a displacement, or of a position from its own origin, in its unit.
+template<typename V>
+[[nodiscard]] constexpr const typename V::rep& glm_numerical_value(const V& v)
+{
+  if constexpr (QuantityPoint<V>)
+    return v.quantity_ref_from(V::point_origin).numerical_value_ref_in(V::unit);
+  else
+    return v.numerical_value_ref_in(V::unit);
+}
+
+template<typename V>
+[[nodiscard]] constexpr V glm_make(const typename V::rep& v)
+{
+  if constexpr (QuantityPoint<V>)
+    return V(typename V::quantity_type(v, V::reference), V::point_origin);
+  else
+    return V(v, V::reference);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Rotates (or, in general, linearly transforms) a batch of displacements or positions.
+ *
+ * Positions are rotated about their origin. The conversion between the units of the input and the
+ * output is folded into the matrix once per batch.
+ */
+MP_UNITS_EXPORT template<typename T, glm::qualifier Q, typename From, typename To, std::size_t E1, std::size_t E2>
+  requires detail::GlmVec3BatchOf<From, To, T, Q>
+constexpr void rotate(const glm::mat<3, 3, T, Q>& r, std::span<const From, E1> from, std::span<To, E2> to)
+{
+  MP_UNITS_EXPECTS(from.size() <= to.size());
+  const glm::mat<3, 3, T, Q> m = r * detail::glm_unit_factor<From::unit, To::unit, T>;
+  for (std::size_t i = 0; i < from.size(); ++i)
+    to[i] = detail::glm_make<To>(m * detail::glm_numerical_value(from[i]));
+}
+
+/**
+ * @brief Translates a batch of positions by a displacement.
+ *
+ * Only points can be translated; translating a displacement is not meaningful and does not compile.
+ */
+MP_UNITS_EXPORT template<Reference auto R, typename T, glm::qualifier Q, typename From, typename To,
+                         std::size_t E1, std::size_t E2>
+  requires detail::GlmVec3BatchOf<From, To, T, Q> && QuantityPoint<From> &&
+           requires(const From& p, const quantity<R, glm::vec<3, T, Q>>& offset) {
+             { p + offset } -> std::convertible_to<To>;
+           }
+constexpr void translate(const quantity<R, glm::vec<3, T, Q>>& offset, std::span<const From, E1> from,
+                         std::span<To, E2> to)
+{
+  MP_UNITS_EXPECTS(from.size() <= to.size());
+  const T k = detail::glm_unit_factor<From::unit, To::unit, T>;
+  const glm::vec<3, T, Q> t = offset.numerical_value_in(To::unit);
+  for (std::size_t i = 0; i < from.size(); ++i)
+    to[i] = detail::glm_make<To>(k * detail::glm_numerical_value(from[i]) + t);
+}
+
+/**
+ * @brief Applies an affine pose to a batch of positions or displacements.
+ *
+ * Positions get the full transform (`w = 1`), displacements only its linear part (`w = 0`), so moving
+ * a rigid body moves its vertices but not the vectors attached to them.
+ *
+ * @tparam U     the unit of the translation of `pose`
+ * @param pose   an affine transform (the last row is `0, 0, 0, 1`)
+ */
+MP_UNITS_EXPORT template<typename T, glm::qualifier Q, Unit U, typename From, typename To, std::size_t E1,
+                         std::size_t E2>
+  requires detail::GlmVec3BatchOf<From, To, T, Q> && UnitOf<U, From::quantity_spec>
+constexpr void transform(const glm::mat<4, 4, T, Q>& pose, U, std::span<const From, E1> from, std::span<To, E2> to)
+{
+  MP_UNITS_EXPECTS(from.size() <= to.size());
+  const T k_in = detail::glm_unit_factor<From::unit, U{}, T>;
+  const T k_out = detail::glm_unit_factor<U{}, To::unit, T>;
+  if constexpr (QuantityPoint<From>) {
+    glm::mat<4, 4, T, Q> m = pose;
+    for (glm::length_t c = 0; c < 3; ++c) m[c] *= k_in * k_out;
+    m[3] *= k_out;
+    m[3][3] = T{1};
+    for (std::size_t i = 0; i < from.size(); ++i) {
+      const glm::vec<4, T, Q> p = m * glm::vec<4, T, Q>(detail::glm_numerical_value(from[i]), T{1});
+      to[i] = detail::glm_make<To>(glm::vec<3, T, Q>(p));
+    }
+  } else {
+    mp_units::rotate(glm::mat<3, 3, T, Q>(pose), from, to);
+  }
+}
+
+/**
+ * @brief Projects a batch of positions to normalized device coordinates (with the perspective divide).
+ *
+ * @tparam U    the unit of the view space `proj` expects
+ * @param proj  a projection matrix (e.g. `glm::perspective()`) working in the unit `U`
+ */
+MP_UNITS_EXPORT template<typename T, glm::qualifier Q, Unit U, typename From, std::size_t E1, std::size_t E2>
+  requires detail::GlmVec3QuantityPoint<From, T, Q> && UnitOf<U, From::quantity_spec>
+constexpr void project(const glm::mat<4, 4, T, Q>& proj, U, std::span<const From, E1> from,
+                       std::span<glm::vec<3, T, Q>, E2> ndc)
+{
+  MP_UNITS_EXPECTS(from.size() <= ndc.size());
+  glm::mat<4, 4, T, Q> m = proj;
+  for (glm::length_t c = 0; c < 3; ++c) m[c] *= detail::glm_unit_factor<From::unit, U{}, T>;
+  for (std::size_t i = 0; i < from.size(); ++i) {
+    const glm::vec<4, T, Q> clip = m * glm::vec<4, T, Q>(detail::glm_numerical_value(from[i]), T{1});
+    ndc[i] = glm::vec<3, T, Q>(clip) / clip.w;
+  }
+}
+
+}  // namespace mp_units
+
 #endif  // __has_include(<glm/geometric.hpp>)
@@ -0,0 +1,247 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// A unit-typed view of an expression-template representation (e.g. an Eigen or Blaze expression)
+// that defers its evaluation until it is assigned to a `quantity`.
+//
+// A `quantity` always stores the evaluated `representation_canonical_type` of its representation, so
+// `a * x + b * y` on `quantity<R, Eigen::VectorXd>` operands materializes one temporary vector per
+// operator. A `lazy_quantity` instead keeps the expression itself and carries the reference on the
+// side: the units are checked and the scaling factors folded in at compile time, and the whole
+// expression is evaluated in a single fused loop when it is converted to a `quantity` (or written into
+// an existing one with `evaluate_into()`).
+//
+//   quantity<isq::displacement[m], Eigen::VectorXd> r = lazy(r0) + dt * lazy(v);
+//
+// Like the expressions of the underlying libraries, a `lazy_quantity` refers to the quantities it was
+// built from, so it must not outlive them; it is meant to be consumed in the full-expression that
+// creates it. `lazy()` refuses temporaries for that reason.
+//
+// This is an add-on for expression-template representations rather than core vocabulary, so it is not
+// part of `<mp-units/framework.h>`: the Eigen and Blaze integration headers include it. Both of their
+// module interface units pull it in, so in module mode its declarations are attached to the global
+// module (`extern "C++"`), which lets a program import both modules. For the same reason it only
+// relies on names that `mp_units.core` exports.
+
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/framework/customization_points.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/reference.h>
+#include <mp-units/framework/unit.h>
+#include <mp-units/framework/unit_magnitude.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#endif
+#endif
+
+#ifdef MP_UNITS_IN_MODULE_INTERFACE
+extern "C++" {
+#endif
+
+namespace mp_units {
+
+MP_UNITS_EXPORT template<Reference auto R, typename Expr>
+class lazy_quantity;
+
+namespace detail {
+
+template<typename T>
+constexpr bool is_lazy_quantity = false;
+
+template<auto R, typename Expr>
+constexpr bool is_lazy_quantity<lazy_quantity<R, Expr>> = true;
+
+template<typename T>
+concept LazyQuantity = is_lazy_quantity<std::remove_cvref_t<T>>;
+
+// The coefficients of a linear combination of expressions of `Element`s: plain values or quantities
+// convertible to them.
+template<typename T, typename Element>
+concept LazyCoefficient = (!Quantity<T>) && (!LazyQuantity<T>) && std::convertible_to<const T&, Element>;
+
+template<typename T, typename Element>
+concept ScalarQuantityOf = Quantity<T> && std::convertible_to<const typename T::rep&, Element>;
+
+template<typename Expr>
+using expression_scalar_t =
+  representation_underlying_type_t<representation_canonical_type_t<std::remove_cvref_t<Expr>>>;
+
+// The expression scaled by the factor between two units, folded at compile time (and omitted when the
+// units have the same magnitude, so the expression is not touched at all).
+template<Unit auto From, Unit auto To, typename Expr>
+[[nodiscard]] constexpr decltype(auto) scale_expression(Expr&& expr)
+{
+  constexpr UnitMagnitude auto m = get_canonical_unit(From).mag / get_canonical_unit(To).mag;
+  if constexpr (m == mag<1>)
+    return std::forward<Expr>(expr);
+  else {
+    return std::forward<Expr>(expr) * get_value<expression_scalar_t<Expr>>(m);
+  }
+}
+
+template<Reference auto R, typename Expr>
+[[nodiscard]] constexpr lazy_quantity<R, std::remove_cvref_t<Expr>> make_lazy_quantity(Expr&& expr)
+{
+  return lazy_quantity<R, std::remove_cvref_t<Expr>>(std::forward<Expr>(expr));
+}
+
+}  // namespace detail
+
+/**
+ * @brief A lazily evaluated quantity whose representation is an expression template.
+ *
+ * @tparam R     the reference of the quantity
+ * @tparam Expr  the expression (or a `const` reference to a concrete vector/matrix for a leaf)
+ */
+MP_UNITS_EXPORT template<Reference auto R, typename Expr>
+class lazy_quantity {
+  Expr expr_;
+
+public:
+  static constexpr Reference auto reference = R;
+  static constexpr QuantitySpec auto quantity_spec = get_quantity_spec(R);
+  static constexpr Unit auto unit = get_unit(R);
+  using expression_type = Expr;
+  using rep = representation_canonical_type_t<std::remove_cvref_t<Expr>>;
+  using scalar_type = detail::expression_scalar_t<Expr>;
+
+  constexpr explicit lazy_quantity(Expr expr) : expr_(std::forward<Expr>(expr)) {}
+
+  [[nodiscard]] constexpr const std::remove_reference_t<Expr>& expression() const { return expr_; }
+
+  /**
+   * @brief Evaluates the expression into a `quantity` of the same reference.
+   */
+  [[nodiscard]] constexpr quantity<R, rep> eval() const { return quantity<R, rep>(rep(expr_), R); }
+
+  /**
+   * @brief Evaluates the expression into a `quantity` the reference is implicitly convertible to.
+   *
+   * The conversion follows the rules of the element type: a truncating unit conversion of an
+   * integral expression is rejected like the one of an integral `quantity`.
+   */
+  template<Reference auto ToR, typename ToRep>
+    requires std::convertible_to<quantity<R, scalar_type>, quantity<ToR, scalar_type>> &&
+             std::constructible_from<ToRep, decltype(detail::scale_expression<unit, get_unit(ToR)>(
+                                              std::declval<const Expr&>()))>
+  constexpr explicit(false) operator quantity<ToR, ToRep>() const
+  {
+    return quantity<ToR, ToRep>(ToRep(detail::scale_expression<unit, get_unit(ToR)>(expr_)), ToR);
+  }
+
+  /**
+   * @brief Evaluates the expression into the storage of an existing quantity (without a temporary).
+   */
+  template<Reference auto ToR, typename ToRep>
+    requires std::convertible_to<quantity<R, scalar_type>, quantity<ToR, scalar_type>>
+  constexpr void evaluate_into(quantity<ToR, ToRep>& q) const
+  {
+    q.numerical_value_ref_in(q.unit) = detail::scale_expression<unit, get_unit(ToR)>(expr_);
+  }
+
+  [[nodiscard]] constexpr auto operator-() const { return detail::make_lazy_quantity<R>(-expr_); }
+
+  template<detail::LazyQuantity Rhs>
+    requires requires { get_common_reference(R, Rhs::reference); }
+  [[nodiscard]] friend constexpr auto operator+(const lazy_quantity& lhs, const Rhs& rhs)
+  {
+    constexpr Reference auto cr = get_common_reference(R, Rhs::reference);
+    return detail::make_lazy_quantity<cr>(detail::scale_expression<unit, get_unit(cr)>(lhs.expr_) +
+                                          detail::scale_expression<Rhs::unit, get_unit(cr)>(rhs.expression()));
+  }
+
+  template<detail::LazyQuantity Rhs>
+    requires requires { get_common_reference(R, Rhs::reference); }
+  [[nodiscard]] friend constexpr auto operator-(const lazy_quantity& lhs, const Rhs& rhs)
+  {
+    constexpr Reference auto cr = get_common_reference(R, Rhs::reference);
+    return detail::make_lazy_quantity<cr>(detail::scale_expression<unit, get_unit(cr)>(lhs.expr_) -
+                                          detail::scale_expression<Rhs::unit, get_unit(cr)>(rhs.expression()));
+  }
+
+  template<detail::ScalarQuantityOf<scalar_type> Q>
+  [[nodiscard]] friend constexpr auto operator*(const lazy_quantity& lhs, const Q& rhs)
+  {
+    return detail::make_lazy_quantity<R * Q::reference>(lhs.expr_ * rhs.numerical_value_ref_in(Q::unit));
+  }
+
+  template<detail::ScalarQuantityOf<scalar_type> Q>
+  [[nodiscard]] friend constexpr auto operator*(const Q& lhs, const lazy_quantity& rhs)
+  {
+    return detail::make_lazy_quantity<Q::reference * R>(lhs.numerical_value_ref_in(Q::unit) * rhs.expr_);
+  }
+
+  template<detail::ScalarQuantityOf<scalar_type> Q>
+  [[nodiscard]] friend constexpr auto operator/(const lazy_quantity& lhs, const Q& rhs)
+  {
+    return detail::make_lazy_quantity<R / Q::reference>(lhs.expr_ / rhs.numerical_value_ref_in(Q::unit));
+  }
+
+  template<typename Value>
+    requires detail::LazyCoefficient<Value, scalar_type>
+  [[nodiscard]] friend constexpr auto operator*(const lazy_quantity& lhs, const Value& rhs)
+  {
+    return detail::make_lazy_quantity<R>(lhs.expr_ * rhs);
+  }
+
+  template<typename Value>
+    requires detail::LazyCoefficient<Value, scalar_type>
+  [[nodiscard]] friend constexpr auto operator*(const Value& lhs, const lazy_quantity& rhs)
+  {
+    return detail::make_lazy_quantity<R>(lhs * rhs.expr_);
+  }
+
+  template<typename Value>
+    requires detail::LazyCoefficient<Value, scalar_type>
+  [[nodiscard]] friend constexpr auto operator/(const lazy_quantity& lhs, const Value& rhs)
+  {
+    return detail::make_lazy_quantity<R>(lhs.expr_ / rhs);
+  }
+};
+
+/**
+ * @brief A lazy view of a quantity with an expression-template representation.
+ *
+ * The view refers to the numerical value of `q`, so it is only available for lvalues.
+ */
+MP_UNITS_EXPORT template<auto R, typename Rep>
+[[nodiscard]] constexpr lazy_quantity<R, const Rep&> lazy(const quantity<R, Rep>& q)
+{
+  return lazy_quantity<R, const Rep&>(q.numerical_value_ref_in(q.unit));
+}
+
+MP_UNITS_EXPORT template<auto R, typename Rep>
+void lazy(const quantity<R, Rep>&&) = delete;
+
+}  // namespace mp_units
+
+#ifdef MP_UNITS_IN_MODULE_INTERFACE
+}
+#endif
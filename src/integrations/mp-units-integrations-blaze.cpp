@@ -22,6 +22,8 @@
 
 module;
 
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/CompressedVector.h>
 #include <blaze/math/DynamicMatrix.h>
 #include <blaze/math/DynamicVector.h>
 #include <blaze/math/StaticMatrix.h>
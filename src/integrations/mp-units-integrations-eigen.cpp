@@ -23,6 +23,7 @@
 module;
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 #include <mp-units/bits/core_gmf.h>
 
 export module mp_units.integrations.eigen;
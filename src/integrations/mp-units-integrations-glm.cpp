@@ -23,10 +23,15 @@
 module;
 
 #include <glm/geometric.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 #include <mp-units/bits/core_gmf.h>
+#ifndef MP_UNITS_IMPORT_STD
+#include <span>
+#endif
 
 export module mp_units.integrations.glm;
 
@@ -36,6 +36,7 @@
 import std;
 #else
 #include <chrono>
+#include <concepts>
 #endif
 #endif
 
@@ -48,7 +49,13 @@ template<typename Period>
 {
   using namespace si;
 
-  if constexpr (is_same_v<Period, std::chrono::nanoseconds::period>)
+  if constexpr (is_same_v<Period, std::atto>)
+    return atto<second>;
+  else if constexpr (is_same_v<Period, std::femto>)
+    return femto<second>;
+  else if constexpr (is_same_v<Period, std::pico>)
+    return pico<second>;
+  else if constexpr (is_same_v<Period, std::chrono::nanoseconds::period>)
     return nano<second>;
   else if constexpr (is_same_v<Period, std::chrono::microseconds::period>)
     return micro<second>;
@@ -150,6 +157,46 @@ template<QuantityPointOf<isq::time> QP>
   return ret_type(to_chrono_duration(qp - qp.absolute_point_origin));
 }
 
+/**
+ * @brief The period of a clock whose tick is only known at runtime
+ *
+ * `std::chrono::duration` fixes its period at compile time, so it cannot describe the counts of a
+ * clock calibrated at startup (e.g. the `rdtsc` CPU timestamp counter). `tick_period` stores the
+ * duration of one tick in the unit of `R` and converts a count of ticks with a single multiply.
+ * Durations with a compile-time period need none of this: they convert to a `quantity` directly,
+ * without touching the count when the units match.
+ *
+ * @tparam R    the reference of the resulting durations
+ * @tparam Rep  the floating-point representation of the period and the resulting durations
+ */
+template<Reference auto R = si::second, std::floating_point Rep = double>
+  requires ReferenceOf<MP_UNITS_REMOVE_CONST(decltype(R)), isq::duration>
+class tick_period {
+  Rep value_;
+public:
+  using rep = Rep;
+  static constexpr Reference auto reference = R;
+  static constexpr Unit auto unit = get_unit(R);
+
+  template<QuantityOf<isq::duration> Q>
+  constexpr explicit tick_period(const Q& period) : value_(period.template in<Rep>(unit).numerical_value_in(unit))
+  {
+  }
+
+  template<QuantityOf<isq::frequency> Q>
+  constexpr explicit tick_period(const Q& frequency) :
+      value_(Rep{1} / frequency.template in<Rep>(one / unit).numerical_value_in(one / unit))
+  {
+  }
+
+  [[nodiscard]] constexpr quantity<R, Rep> period() const { return quantity<R, Rep>{value_, R}; }
+
+  [[nodiscard]] constexpr quantity<R, Rep> operator()(std::integral auto ticks) const
+  {
+    return quantity<R, Rep>{static_cast<Rep>(ticks) * value_, R};
+  }
+};
+
 MP_UNITS_EXPORT_END
 
 }  // namespace mp_units
@@ -0,0 +1,260 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/quantity_concepts.h>
+#include <mp-units/utility/bits/sharding.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#endif
+#endif
+
+namespace mp_units::utility {
+
+namespace detail {
+
+template<typename T>
+concept AtomicQuantityRep = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+template<typename Rep>
+Rep atomic_fetch_add(std::atomic<Rep>& a, Rep delta, std::memory_order order) noexcept
+{
+  if constexpr (std::integral<Rep>)
+    return a.fetch_add(delta, order);
+  else {
+    // not every standard library provides `fetch_add` for floating-point atomics yet
+    Rep old = a.load(std::memory_order_relaxed);
+    while (!a.compare_exchange_weak(old, old + delta, order, std::memory_order_relaxed)) {
+    }
+    return old;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief An atomic quantity supporting lock-free accumulation
+ *
+ * `std::atomic<quantity<...>>` only provides loads, stores and exchanges. `atomic_quantity`
+ * adds `fetch_add` and `fetch_sub` accepting any quantity implicitly convertible to `Q`.
+ * The argument is converted to the unit and representation of `Q` before touching the
+ * atomic, so the read-modify-write itself is a native `fetch_add` for integral representation
+ * types and a single `compare_exchange_weak` loop for floating-point ones.
+ *
+ * @tparam Q  the stored quantity type (e.g. `quantity<iec::byte, std::uint64_t>`)
+ */
+MP_UNITS_EXPORT template<Quantity Q>
+  requires detail::AtomicQuantityRep<typename Q::rep>
+class atomic_quantity {
+  std::atomic<typename Q::rep> value_{};
+public:
+  using value_type = Q;
+  using rep = Q::rep;
+  static constexpr bool is_always_lock_free = std::atomic<rep>::is_always_lock_free;
+
+  atomic_quantity() = default;
+  constexpr explicit(false) atomic_quantity(const Q& q) noexcept : value_(q.numerical_value_in(Q::unit)) {}
+
+  atomic_quantity(const atomic_quantity&) = delete;
+  atomic_quantity& operator=(const atomic_quantity&) = delete;
+
+  [[nodiscard]] bool is_lock_free() const noexcept { return value_.is_lock_free(); }
+
+  [[nodiscard]] Q load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+  {
+    return value_.load(order) * Q::reference;
+  }
+  [[nodiscard]] explicit(false) operator Q() const noexcept { return load(); }
+
+  void store(const Q& q, std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    value_.store(q.numerical_value_in(Q::unit), order);
+  }
+  Q operator=(const Q& q) noexcept
+  {
+    store(q);
+    return q;
+  }
+
+  Q exchange(const Q& q, std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    return value_.exchange(q.numerical_value_in(Q::unit), order) * Q::reference;
+  }
+
+  bool compare_exchange_weak(Q& expected, const Q& desired,
+                             std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    rep exp = expected.numerical_value_in(Q::unit);
+    const bool res = value_.compare_exchange_weak(exp, desired.numerical_value_in(Q::unit), order);
+    if (!res) expected = exp * Q::reference;
+    return res;
+  }
+
+  bool compare_exchange_strong(Q& expected, const Q& desired,
+                               std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    rep exp = expected.numerical_value_in(Q::unit);
+    const bool res = value_.compare_exchange_strong(exp, desired.numerical_value_in(Q::unit), order);
+    if (!res) expected = exp * Q::reference;
+    return res;
+  }
+
+  /**
+   * @brief Atomically adds `q` and returns the previous value
+   */
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  Q fetch_add(const Q2& q, std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    const rep delta = Q(q).numerical_value_in(Q::unit);
+    return detail::atomic_fetch_add(value_, delta, order) * Q::reference;
+  }
+
+  /**
+   * @brief Atomically subtracts `q` and returns the previous value
+   */
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  Q fetch_sub(const Q2& q, std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    const rep delta = Q(q).numerical_value_in(Q::unit);
+    if constexpr (std::integral<rep>)
+      return value_.fetch_sub(delta, order) * Q::reference;
+    else
+      return detail::atomic_fetch_add(value_, static_cast<rep>(-delta), order) * Q::reference;
+  }
+
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  Q operator+=(const Q2& q) noexcept
+  {
+    const Q delta = q;
+    return fetch_add(delta) + delta;
+  }
+
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  Q operator-=(const Q2& q) noexcept
+  {
+    const Q delta = q;
+    return fetch_sub(delta) - delta;
+  }
+};
+
+/**
+ * @brief A contention-free accumulator built from per-thread shards
+ *
+ * Each thread updates its own cache-line-padded `atomic_quantity`, so concurrent writers never
+ * share a cache line (as long as there are no more active threads than shards). Reads
+ * aggregate all the shards, which makes them `O(Shards)` and only eventually consistent with
+ * in-flight updates. Use it for write-heavy counters (metrics, telemetry) and `atomic_quantity`
+ * when every read needs a linearizable value.
+ *
+ * @tparam Q       the stored quantity type
+ * @tparam Shards  the number of shards
+ */
+MP_UNITS_EXPORT template<Quantity Q, std::size_t Shards = 64>
+  requires detail::AtomicQuantityRep<typename Q::rep> && (Shards > 0)
+class sharded_atomic_quantity {
+  struct alignas(detail::cache_line_size) shard {
+    atomic_quantity<Q> value;
+  };
+  std::array<shard, Shards> shards_{};
+
+  [[nodiscard]] atomic_quantity<Q>& local() noexcept
+  {
+    return shards_[detail::this_thread_shard_id() % Shards].value;
+  }
+public:
+  using value_type = Q;
+  using rep = Q::rep;
+  static constexpr std::size_t shard_count = Shards;
+
+  sharded_atomic_quantity() = default;
+  sharded_atomic_quantity(const sharded_atomic_quantity&) = delete;
+  sharded_atomic_quantity& operator=(const sharded_atomic_quantity&) = delete;
+
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  void add(const Q2& q, std::memory_order order = std::memory_order_relaxed) noexcept
+  {
+    local().fetch_add(q, order);
+  }
+
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  void subtract(const Q2& q, std::memory_order order = std::memory_order_relaxed) noexcept
+  {
+    local().fetch_sub(q, order);
+  }
+
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  sharded_atomic_quantity& operator+=(const Q2& q) noexcept
+  {
+    add(q);
+    return *this;
+  }
+
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  sharded_atomic_quantity& operator-=(const Q2& q) noexcept
+  {
+    subtract(q);
+    return *this;
+  }
+
+  /**
+   * @brief The sum of all the shards
+   */
+  [[nodiscard]] Q load(std::memory_order order = std::memory_order_relaxed) const noexcept
+  {
+    rep sum{};
+    for (const shard& s : shards_) sum += s.value.load(order).numerical_value_in(Q::unit);
+    return sum * Q::reference;
+  }
+
+  /**
+   * @brief Resets all the shards to zero and returns the sum of their previous values
+   */
+  Q exchange_zero(std::memory_order order = std::memory_order_acq_rel) noexcept
+  {
+    rep sum{};
+    for (shard& s : shards_) sum += s.value.exchange(rep{} * Q::reference, order).numerical_value_in(Q::unit);
+    return sum * Q::reference;
+  }
+};
+
+}  // namespace mp_units::utility
@@ -0,0 +1,96 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/bits/fixed_point.h>
+#include <mp-units/framework/customization_points.h>
+#include <mp-units/framework/unit_magnitude.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#endif
+#endif
+
+namespace mp_units::utility::detail {
+
+// The exact terms `{num, den}` of a positive rational magnitude, or `{0, 0}` if they do not fit in 64 bits.
+template<UnitMagnitude auto M>
+[[nodiscard]] consteval std::array<std::uint64_t, 2> exact_magnitude()
+{
+  if constexpr (is_rational(M) && get_value<double>(M) > 0) {
+    constexpr auto num = try_get_value<std::uint64_t>(numerator(M));
+    constexpr auto den = try_get_value<std::uint64_t>(denominator(M));
+    if constexpr (num.has_value() && den.has_value()) return {*num, *den};
+  }
+  return {0, 0};
+}
+
+template<std::integral T>
+using wide_integer_t =
+  std::conditional_t<std::is_signed_v<T>, ::mp_units::detail::int128_t, ::mp_units::detail::uint128_t>;
+
+// `v * num / den` truncated toward zero like `scale_int`; a 64-bit value times a 64-bit numerator
+// always fits in the 128-bit intermediate
+template<std::integral T>
+[[nodiscard]] constexpr wide_integer_t<T> scale_exact(T v, std::uint64_t num, std::uint64_t den)
+{
+  using wide = wide_integer_t<T>;
+  const wide scaled = static_cast<wide>(v) * static_cast<wide>(num);
+  return den == 1 ? scaled : scaled / static_cast<wide>(den);
+}
+
+// `v * num / den` as `To`: truncated for an integral `To` (which may wrap, see `fits_in`), and
+// rounded only once for a floating-point one
+template<typename To, std::integral From>
+[[nodiscard]] constexpr To scale_exact_as(From v, std::uint64_t num, std::uint64_t den)
+{
+  if constexpr (treat_as_floating_point<To>) {
+    using wide = wide_integer_t<From>;
+    const wide scaled = static_cast<wide>(v) * static_cast<wide>(num);
+    if (den == 1 || scaled % static_cast<wide>(den) == 0) return static_cast<To>(scaled / static_cast<wide>(den));
+    return static_cast<To>(scaled) / static_cast<To>(den);
+  } else
+    return static_cast<To>(scale_exact(v, num, den));
+}
+
+// whether the result of `scale_exact` for a value of `From` is representable as `To`
+template<std::integral To, std::integral From>
+[[nodiscard]] constexpr bool fits_in(wide_integer_t<From> v)
+{
+  using wide = wide_integer_t<From>;
+  if constexpr (std::is_signed_v<From>)
+    if (v < static_cast<wide>(std::numeric_limits<To>::min())) return false;
+  return v <= static_cast<wide>(std::numeric_limits<To>::max());
+}
+
+}  // namespace mp_units::utility::detail
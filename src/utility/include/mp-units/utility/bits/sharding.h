@@ -0,0 +1,57 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <atomic>
+#include <cstddef>
+#endif
+#endif
+
+namespace mp_units::utility::detail {
+
+// Fixed rather than `std::hardware_destructive_interference_size`, whose value is not ABI-stable
+// (GCC warns on every use) and which is missing from some standard libraries.
+inline constexpr std::size_t cache_line_size = 64;
+
+/**
+ * @brief A small dense id of the calling thread used to pick a shard
+ *
+ * Ids are handed out round-robin on the first call from each thread, so `N` threads updating a
+ * sharded object with at least `N` shards never share a slot.
+ */
+[[nodiscard]] inline std::size_t this_thread_shard_id() noexcept
+{
+  static std::atomic<std::size_t> next_id{0};
+  thread_local const std::size_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+}  // namespace mp_units::utility::detail
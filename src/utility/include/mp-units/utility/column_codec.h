@@ -0,0 +1,505 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/compat_macros.h>
+#include <mp-units/framework/dimension.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/quantity_concepts.h>
+#include <mp-units/framework/quantity_point.h>
+#include <mp-units/framework/quantity_point_concepts.h>
+#include <mp-units/framework/unit.h>
+#include <mp-units/utility/bits/exact_scaling.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+#endif
+
+namespace mp_units::utility {
+
+/**
+ * @brief The name recorded in a column file for the origin of a column of quantity points
+ *
+ * Natural origins are recorded as `"natural"` automatically. Any other origin has to be named by
+ * specializing this variable template (e.g. `point_origin_name<si::ice_point> = "ice_point"`),
+ * so that a column cannot be read back relative to a different origin.
+ */
+MP_UNITS_EXPORT template<PointOrigin auto PO>
+constexpr std::string_view point_origin_name{};
+
+namespace detail {
+
+template<typename T>
+[[nodiscard]] consteval std::string_view column_point_origin()
+{
+  if constexpr (Quantity<T>)
+    return {};
+  else if constexpr (std::same_as<std::remove_const_t<decltype(T::point_origin)>,
+                                  std::remove_const_t<decltype(natural_point_origin<T::quantity_spec>)>>)
+    return "natural";
+  else
+    return point_origin_name<T::point_origin>;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A type that a column file stores as a raw array of its arithmetic representation
+ *
+ * A quantity, or a quantity point with a natural or a named origin (see `point_origin_name`), with
+ * no storage besides its numerical value, so a contiguous range of them is written as is.
+ */
+MP_UNITS_EXPORT template<typename T>
+concept ColumnElement = (Quantity<T> || QuantityPoint<T>) && std::is_arithmetic_v<typename T::rep> &&
+                        (!std::same_as<typename T::rep, bool>) && std::is_trivially_copyable_v<T> &&
+                        sizeof(T) == sizeof(typename T::rep) &&
+                        (Quantity<T> || !detail::column_point_origin<T>().empty());
+
+MP_UNITS_EXPORT enum class rep_kind : std::uint8_t {
+  signed_integer = 'i',
+  unsigned_integer = 'u',
+  floating_point = 'f'
+};
+
+/**
+ * @brief The metadata of one column of a column file
+ *
+ * The symbols use the portable character set. The unit is described both by its symbol and by its
+ * magnitude relative to the reference unit of its canonical form, so a reader can rescale a column
+ * stored in any unit of the same kind (e.g. `km` for `m`) without knowing the unit at compile time.
+ * The magnitude is recorded as a `double` and, when it is rational with 64-bit terms, also exactly
+ * as `magnitude_num / magnitude_den` (both are `0` otherwise).
+ */
+MP_UNITS_EXPORT struct column_header {
+  rep_kind kind{};
+  std::uint8_t rep_size{};
+  std::string unit_symbol;
+  std::string dimension_symbol;
+  std::string canonical_unit_symbol;
+  double magnitude{};
+  std::uint64_t magnitude_num{};
+  std::uint64_t magnitude_den{};
+  std::string point_origin;  // empty for quantities
+  std::uint64_t size{};
+  std::uint64_t offset{};  // of the data, from the beginning of the file
+
+  [[nodiscard]] bool operator==(const column_header&) const = default;
+};
+
+/**
+ * @brief The metadata describing a column of `T` (with the size and offset left to the caller)
+ */
+MP_UNITS_EXPORT template<ColumnElement T>
+[[nodiscard]] column_header make_column_header(std::uint64_t size = 0)
+{
+  using rep = T::rep;
+  constexpr auto canonical = get_canonical_unit(T::unit);
+  constexpr auto usf = unit_symbol_formatting{.char_set = character_set::portable};
+  constexpr auto dsf = dimension_symbol_formatting{.char_set = character_set::portable};
+  return {.kind = std::floating_point<rep>   ? rep_kind::floating_point
+                  : std::is_signed_v<rep> ? rep_kind::signed_integer
+                                          : rep_kind::unsigned_integer,
+          .rep_size = static_cast<std::uint8_t>(sizeof(rep)),
+          .unit_symbol = std::string(unit_symbol<usf>(T::unit)),
+          .dimension_symbol = std::string(dimension_symbol<dsf>(T::dimension)),
+          .canonical_unit_symbol = std::string(unit_symbol<usf>(canonical.reference_unit)),
+          .magnitude = get_value<double>(canonical.mag),
+          .magnitude_num = detail::exact_magnitude<canonical.mag>()[0],
+          .magnitude_den = detail::exact_magnitude<canonical.mag>()[1],
+          .point_origin = std::string(detail::column_point_origin<T>()),
+          .size = size,
+          .offset = 0};
+}
+
+namespace detail {
+
+inline constexpr std::array<char, 4> column_file_magic = {'M', 'P', 'U', 'C'};
+inline constexpr std::uint16_t column_file_version = 1;
+
+// The data of every column starts at a multiple of this offset, so a mapped file can be accessed
+// in place as an array of any representation type.
+inline constexpr std::uint64_t column_data_alignment = 64;
+
+[[nodiscard]] constexpr std::uint64_t align_column_offset(std::uint64_t offset)
+{
+  return (offset + column_data_alignment - 1) / column_data_alignment * column_data_alignment;
+}
+
+template<typename T>
+using column_bits_t = std::conditional_t<
+  sizeof(T) == 1, std::uint8_t,
+  std::conditional_t<sizeof(T) == 2, std::uint16_t, std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+// the little-endian byte order of a value
+template<typename T>
+  requires std::is_arithmetic_v<T>
+[[nodiscard]] constexpr T to_little_endian(T v)
+{
+  if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1)
+    return v;
+  else {
+    auto bits = std::bit_cast<column_bits_t<T>>(v);
+    column_bits_t<T> res = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i, bits >>= 8)
+      res = static_cast<column_bits_t<T>>((res << 8) | (bits & 0xFF));
+    return std::bit_cast<T>(res);
+  }
+}
+
+template<typename T>
+void write_column_value(std::ostream& os, T v)
+{
+  const T le = to_little_endian(v);
+  os.write(reinterpret_cast<const char*>(&le), sizeof(T));
+}
+
+inline void write_column_string(std::ostream& os, std::string_view s)
+{
+  write_column_value(os, static_cast<std::uint16_t>(s.size()));
+  os.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+inline void read_column_bytes(std::istream& is, char* data, std::size_t size)
+{
+  if (!is.read(data, static_cast<std::streamsize>(size))) throw std::runtime_error("truncated column file");
+}
+
+template<typename T>
+[[nodiscard]] T read_column_value(std::istream& is)
+{
+  T v;
+  read_column_bytes(is, reinterpret_cast<char*>(&v), sizeof(T));
+  return to_little_endian(v);
+}
+
+[[nodiscard]] inline std::string read_column_string(std::istream& is)
+{
+  std::string res(read_column_value<std::uint16_t>(is), '\0');
+  read_column_bytes(is, res.data(), res.size());
+  return res;
+}
+
+[[nodiscard]] inline std::uint64_t column_header_bytes(const column_header& h)
+{
+  // the representation (2 bytes), the magnitude, its exact terms, the size and the offset (8 bytes each),
+  // and the 4 strings prefixed with their lengths (2 bytes each)
+  return 2 + 5 * 8 + 4 * 2 + h.unit_symbol.size() + h.dimension_symbol.size() + h.canonical_unit_symbol.size() +
+         h.point_origin.size();
+}
+
+inline void write_column_header(std::ostream& os, const column_header& h)
+{
+  write_column_value(os, static_cast<std::uint8_t>(h.kind));
+  write_column_value(os, h.rep_size);
+  write_column_string(os, h.unit_symbol);
+  write_column_string(os, h.dimension_symbol);
+  write_column_string(os, h.canonical_unit_symbol);
+  write_column_value(os, h.magnitude);
+  write_column_value(os, h.magnitude_num);
+  write_column_value(os, h.magnitude_den);
+  write_column_string(os, h.point_origin);
+  write_column_value(os, h.size);
+  write_column_value(os, h.offset);
+}
+
+[[nodiscard]] inline column_header read_column_header(std::istream& is)
+{
+  column_header h;
+  h.kind = static_cast<rep_kind>(read_column_value<std::uint8_t>(is));
+  h.rep_size = read_column_value<std::uint8_t>(is);
+  h.unit_symbol = read_column_string(is);
+  h.dimension_symbol = read_column_string(is);
+  h.canonical_unit_symbol = read_column_string(is);
+  h.magnitude = read_column_value<double>(is);
+  h.magnitude_num = read_column_value<std::uint64_t>(is);
+  h.magnitude_den = read_column_value<std::uint64_t>(is);
+  h.point_origin = read_column_string(is);
+  h.size = read_column_value<std::uint64_t>(is);
+  h.offset = read_column_value<std::uint64_t>(is);
+  return h;
+}
+
+template<typename T>
+[[nodiscard]] const T::rep* column_data(std::span<const T> column)
+{
+  return reinterpret_cast<const T::rep*>(column.data());
+}
+
+// Calls `f(std::type_identity<Rep>{})` with the arithmetic type a column is stored as.
+template<typename F>
+decltype(auto) visit_column_rep(const column_header& h, F&& f)
+{
+  const auto size = h.rep_size;
+  switch (h.kind) {
+    case rep_kind::floating_point:
+      if (size == sizeof(float)) return f(std::type_identity<float>{});
+      if (size == sizeof(double)) return f(std::type_identity<double>{});
+      break;
+    case rep_kind::signed_integer:
+      if (size == 1) return f(std::type_identity<std::int8_t>{});
+      if (size == 2) return f(std::type_identity<std::int16_t>{});
+      if (size == 4) return f(std::type_identity<std::int32_t>{});
+      if (size == 8) return f(std::type_identity<std::int64_t>{});
+      break;
+    case rep_kind::unsigned_integer:
+      if (size == 1) return f(std::type_identity<std::uint8_t>{});
+      if (size == 2) return f(std::type_identity<std::uint16_t>{});
+      if (size == 4) return f(std::type_identity<std::uint32_t>{});
+      if (size == 8) return f(std::type_identity<std::uint64_t>{});
+      break;
+  }
+  throw std::runtime_error("unsupported representation type in a column file");
+}
+
+}  // namespace detail
+
+/**
+ * @brief How the values of a column are turned into `T`
+ *
+ * A column stored with the unit and representation type of `T` is taken as is. Otherwise, every
+ * value is scaled by the ratio of the magnitudes of the two units: exactly (`num / den`, with
+ * 128-bit intermediates like the library's integral scaling) when both magnitudes are rational,
+ * and by the `double` `factor` otherwise.
+ *
+ * As with the implicit conversions of `quantity`, an integral `T` can only be read from an
+ * integral column of the same signedness and no wider representation, scaled by an integral factor
+ * (e.g. `ms` as `us`, or `int32_t` as `int64_t`); anything that could truncate requires a
+ * floating-point `T`. Throws `std::invalid_argument` if the column does not hold values of the same
+ * dimension, reference unit and origin as `T`, or cannot be converted to `T` without truncation.
+ * A value that does not fit in an integral `T` once scaled throws `std::overflow_error` when read.
+ */
+MP_UNITS_EXPORT struct column_conversion {
+  bool as_is;
+  double factor;
+  std::uint64_t num;  // the exact factor, or `0 / 0` if there is none
+  std::uint64_t den;
+
+  [[nodiscard]] constexpr bool exact() const noexcept { return den != 0; }
+
+  template<ColumnElement T>
+  [[nodiscard]] static column_conversion to(const column_header& h)
+  {
+    const column_header expected = make_column_header<T>();
+    if (h.dimension_symbol != expected.dimension_symbol || h.canonical_unit_symbol != expected.canonical_unit_symbol)
+      throw std::invalid_argument("a column of '" + h.unit_symbol + "' cannot be read as '" + expected.unit_symbol +
+                                  "'");
+    if (h.point_origin != expected.point_origin)
+      throw std::invalid_argument("a column relative to the origin '" + h.point_origin +
+                                  "' cannot be read relative to '" + expected.point_origin + "'");
+    const bool same_unit = h.unit_symbol == expected.unit_symbol && h.magnitude == expected.magnitude;
+    if (same_unit && h.kind == expected.kind && h.rep_size == expected.rep_size) return {true, 1., 1, 1};
+
+    column_conversion res{false, h.magnitude / expected.magnitude, 0, 0};
+    if (same_unit)
+      res = {false, 1., 1, 1};
+    else if (h.magnitude_den != 0 && expected.magnitude_den != 0) {
+      // (a / b) / (c / d) = (a * d) / (b * c), reduced
+      using wide = detail::wide_integer_t<std::uint64_t>;
+      auto num = static_cast<wide>(h.magnitude_num) * expected.magnitude_den;
+      auto den = static_cast<wide>(h.magnitude_den) * expected.magnitude_num;
+      auto a = num;
+      auto b = den;
+      while (b != 0) a = std::exchange(b, a % b);
+      num /= a;
+      den /= a;
+      constexpr auto max = static_cast<wide>(std::numeric_limits<std::uint64_t>::max());
+      if (num <= max && den <= max)
+        res = {false, static_cast<double>(num) / static_cast<double>(den), static_cast<std::uint64_t>(num),
+               static_cast<std::uint64_t>(den)};
+    }
+
+    if constexpr (!treat_as_floating_point<typename T::rep>) {
+      if (h.kind == rep_kind::floating_point)
+        throw std::invalid_argument("a floating-point column of '" + h.unit_symbol + "' cannot be read with '" +
+                                    expected.unit_symbol + "' of an integral representation type");
+      if ((h.kind == rep_kind::signed_integer) != std::is_signed_v<typename T::rep> ||
+          h.rep_size > sizeof(typename T::rep))
+        throw std::invalid_argument("a column of '" + h.unit_symbol + "' stored as '" + static_cast<char>(h.kind) +
+                                    std::to_string(8 * h.rep_size) +
+                                    "' cannot be read with a narrower or differently signed representation type");
+      if (res.den != 1)
+        throw std::invalid_argument("a column of '" + h.unit_symbol + "' can be read as '" + expected.unit_symbol +
+                                    "' only with a floating-point representation type (the factor is not integral)");
+    }
+    return res;
+  }
+};
+
+namespace detail {
+
+// Scales a value stored as `From` by `c` (a conversion already validated for `To`).
+template<typename To, typename From>
+[[nodiscard]] constexpr To scale_column_value(From v, const column_conversion& c)
+{
+  if constexpr (std::integral<From>) {
+    if (c.exact()) {
+      if constexpr (treat_as_floating_point<To>)
+        return scale_exact_as<To>(v, c.num, c.den);
+      else {
+        const auto scaled = scale_exact(v, c.num, c.den);
+        if (!fits_in<To, From>(scaled))
+          throw std::overflow_error("a column value does not fit in the representation type once scaled");
+        return static_cast<To>(scaled);
+      }
+    }
+  }
+  return static_cast<To>(static_cast<double>(v) * c.factor);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Writes contiguous ranges of quantities (or quantity points) as a column file
+ *
+ * The file starts with a header recording, once per column, its unit, dimension, representation
+ * type, origin and size, and is followed by the raw little-endian values of every column. On a
+ * little-endian platform the values are written straight from the memory of the spans.
+ */
+MP_UNITS_EXPORT template<ColumnElement... Ts>
+void write_columns(std::ostream& os, std::span<const Ts>... columns)
+{
+  std::array<column_header, sizeof...(Ts)> headers = {make_column_header<Ts>(columns.size())...};
+  std::uint64_t offset = detail::column_file_magic.size() + 2 + 2;
+  for (const column_header& h : headers) offset += detail::column_header_bytes(h);
+  for (column_header& h : headers) {
+    h.offset = offset = detail::align_column_offset(offset);
+    offset += h.size * h.rep_size;
+  }
+
+  os.write(detail::column_file_magic.data(), detail::column_file_magic.size());
+  detail::write_column_value(os, detail::column_file_version);
+  detail::write_column_value(os, static_cast<std::uint16_t>(sizeof...(Ts)));
+  std::uint64_t pos = detail::column_file_magic.size() + 2 + 2;
+  for (const column_header& h : headers) {
+    detail::write_column_header(os, h);
+    pos += detail::column_header_bytes(h);
+  }
+
+  std::size_t index = 0;
+  auto write_data = [&]<typename T>(std::span<const T> column) {
+    const column_header& h = headers[index++];
+    for (; pos < h.offset; ++pos) os.put('\0');
+    const auto* data = detail::column_data(column);
+    if constexpr (std::endian::native == std::endian::little)
+      os.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(column.size_bytes()));
+    else
+      for (std::size_t i = 0; i < column.size(); ++i) detail::write_column_value(os, data[i]);
+    pos += column.size_bytes();
+  };
+  (write_data(columns), ...);
+  if (!os) throw std::runtime_error("failed to write a column file");
+}
+
+/**
+ * @brief Reads the columns written by `write_columns`
+ *
+ * The header is parsed when the reader is constructed. Reading a column as `T` validates the column
+ * metadata against `T` first (see `column_conversion`), then either loads the raw values directly
+ * into the destination or scales them by the conversion factor while loading.
+ */
+MP_UNITS_EXPORT class column_reader {
+  std::istream* is_;
+  std::istream::pos_type base_;
+  std::vector<column_header> columns_;
+
+  template<typename Rep, typename T>
+  void load(const column_conversion& conv, std::span<T> out)
+  {
+    constexpr std::size_t chunk = 4096;
+    std::array<Rep, chunk> buffer;
+    auto* data = reinterpret_cast<T::rep*>(out.data());
+    for (std::size_t i = 0; i < out.size(); i += chunk) {
+      const std::size_t n = std::min(chunk, out.size() - i);
+      detail::read_column_bytes(*is_, reinterpret_cast<char*>(buffer.data()), n * sizeof(Rep));
+      for (std::size_t j = 0; j < n; ++j)
+        data[i + j] = detail::scale_column_value<typename T::rep>(detail::to_little_endian(buffer[j]), conv);
+    }
+  }
+
+public:
+  explicit column_reader(std::istream& is) : is_(&is), base_(is.tellg())
+  {
+    std::array<char, 4> magic{};
+    detail::read_column_bytes(is, magic.data(), magic.size());
+    if (magic != detail::column_file_magic) throw std::runtime_error("not a column file");
+    if (detail::read_column_value<std::uint16_t>(is) != detail::column_file_version)
+      throw std::runtime_error("unsupported column file version");
+    const auto count = detail::read_column_value<std::uint16_t>(is);
+    columns_.reserve(count);
+    for (std::uint16_t i = 0; i < count; ++i) columns_.push_back(detail::read_column_header(is));
+  }
+
+  [[nodiscard]] const std::vector<column_header>& columns() const noexcept { return columns_; }
+
+  /**
+   * @brief Reads the column `index` into `out`, which must have exactly its size
+   */
+  template<ColumnElement T>
+  void read(std::size_t index, std::span<T> out)
+  {
+    const column_header& h = columns_.at(index);
+    const column_conversion conv = column_conversion::to<T>(h);
+    if (out.size() != h.size) throw std::invalid_argument("the size of the output does not match the column");
+    is_->seekg(base_ + static_cast<std::streamoff>(h.offset));
+    if (conv.as_is) {
+      auto* data = reinterpret_cast<T::rep*>(out.data());
+      detail::read_column_bytes(*is_, reinterpret_cast<char*>(data), out.size_bytes());
+      if constexpr (std::endian::native != std::endian::little)
+        for (std::size_t i = 0; i < out.size(); ++i) data[i] = detail::to_little_endian(data[i]);
+    } else {
+      detail::visit_column_rep(h, [&]<typename Rep>(std::type_identity<Rep>) { load<Rep>(conv, out); });
+    }
+  }
+
+  template<ColumnElement T>
+  [[nodiscard]] std::vector<T> read(std::size_t index)
+  {
+    std::vector<T> res(columns_.at(index).size);
+    read(index, std::span{res});
+    return res;
+  }
+};
+
+}  // namespace mp_units::utility
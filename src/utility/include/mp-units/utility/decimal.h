@@ -0,0 +1,468 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/bits/fixed_point.h>
+#include <mp-units/bits/fmt.h>
+#include <mp-units/compat_macros.h>
+#include <mp-units/framework/customization_points.h>
+#include <mp-units/framework/representation_concepts.h>
+#include <mp-units/framework/unit_magnitude.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#endif
+#endif
+
+namespace mp_units::utility {
+
+// ============================================================================
+// Rounding policies
+//
+// A policy only decides whether a truncated quotient has to be moved one step away from zero.
+// It gets the comparison of the discarded remainder against one half of the divisor and the
+// parity of the truncated quotient, which is enough to express every sign-symmetric policy.
+// ============================================================================
+
+MP_UNITS_EXPORT template<typename P>
+concept DecimalRoundingPolicy = requires(std::strong_ordering remainder_vs_half, bool odd_quotient) {
+  { P::round_away_from_zero(remainder_vs_half, odd_quotient) } -> std::same_as<bool>;
+};
+
+/**
+ * @brief Rounds half-way cases to the nearest even digit (banker's rounding).
+ *
+ * Unbiased over many operations; the default for `decimal`.
+ */
+MP_UNITS_EXPORT struct round_half_even {
+  [[nodiscard]] static constexpr bool round_away_from_zero(std::strong_ordering remainder_vs_half,
+                                                           bool odd_quotient) noexcept
+  {
+    return remainder_vs_half > 0 || (remainder_vs_half == 0 && odd_quotient);
+  }
+};
+
+/**
+ * @brief Rounds half-way cases away from zero (commercial rounding).
+ */
+MP_UNITS_EXPORT struct round_half_up {
+  [[nodiscard]] static constexpr bool round_away_from_zero(std::strong_ordering remainder_vs_half, bool) noexcept
+  {
+    return remainder_vs_half >= 0;
+  }
+};
+
+/**
+ * @brief Discards the excess digits (truncation).
+ */
+MP_UNITS_EXPORT struct round_toward_zero {
+  [[nodiscard]] static constexpr bool round_away_from_zero(std::strong_ordering, bool) noexcept { return false; }
+};
+
+MP_UNITS_EXPORT template<std::signed_integral T, int Digits, DecimalRoundingPolicy RoundingPolicy = round_half_even>
+  requires(Digits >= 0 && Digits <= std::numeric_limits<T>::digits10)
+class decimal;
+
+namespace detail {
+
+using namespace ::mp_units::detail;
+
+// All intermediate results are computed in 128 bits: the product of two 64-bit raw values (or
+// of a raw value and a 64-bit magnitude factor) always fits, so no operation can overflow before
+// the final, rounded narrowing back to `T`.
+using decimal_wide_t = int128_t;
+
+[[nodiscard]] consteval std::int64_t pow10(int exp)
+{
+  std::int64_t res = 1;
+  for (int i = 0; i < exp; ++i) res *= 10;
+  return res;
+}
+
+template<typename T>
+[[nodiscard]] constexpr T decimal_abs(T v)
+{
+  return v < T{0} ? -v : v;
+}
+
+// `num / den` (with `den > 0`) with the quotient rounded according to `Policy`.
+template<DecimalRoundingPolicy Policy>
+[[nodiscard]] constexpr decimal_wide_t rounded_div(decimal_wide_t num, decimal_wide_t den)
+{
+  const decimal_wide_t quot = num / den;
+  const decimal_wide_t rem = num - quot * den;
+  if (rem == decimal_wide_t{0}) return quot;
+  const decimal_wide_t twice_rem = decimal_abs(rem) * decimal_wide_t{2};
+  const std::strong_ordering vs_half = twice_rem < den    ? std::strong_ordering::less
+                                       : twice_rem == den ? std::strong_ordering::equal
+                                                          : std::strong_ordering::greater;
+  const bool odd = (quot - quot / decimal_wide_t{2} * decimal_wide_t{2}) != decimal_wide_t{0};
+  if (!Policy::round_away_from_zero(vs_half, odd)) return quot;
+  return num < decimal_wide_t{0} ? quot - decimal_wide_t{1} : quot + decimal_wide_t{1};
+}
+
+template<DecimalRoundingPolicy Policy, std::floating_point F>
+[[nodiscard]] constexpr decimal_wide_t rounded_from_floating(F v)
+{
+  const auto trunc = static_cast<decimal_wide_t>(v);
+  const F frac = decimal_abs(v - static_cast<F>(trunc));
+  if (frac == F{0}) return trunc;
+  const std::strong_ordering vs_half = frac < F{0.5}    ? std::strong_ordering::less
+                                       : frac == F{0.5} ? std::strong_ordering::equal
+                                                        : std::strong_ordering::greater;
+  const bool odd = (trunc - trunc / decimal_wide_t{2} * decimal_wide_t{2}) != decimal_wide_t{0};
+  if (!Policy::round_away_from_zero(vs_half, odd)) return trunc;
+  return v < F{0} ? trunc - decimal_wide_t{1} : trunc + decimal_wide_t{1};
+}
+
+template<typename T>
+[[nodiscard]] constexpr T narrow_decimal(decimal_wide_t v)
+{
+  MP_UNITS_EXPECTS_DEBUG(v >= static_cast<decimal_wide_t>(std::numeric_limits<T>::min()) &&
+                         v <= static_cast<decimal_wide_t>(std::numeric_limits<T>::max()));
+  return static_cast<T>(v);
+}
+
+// Enough room for the sign, 19 integral digits, the decimal point, and the fractional digits.
+inline constexpr std::size_t decimal_max_chars = 48;
+
+// Renders the raw scaled integer as `[-]integral[.fraction]` with exactly `Digits` fractional
+// digits. The magnitude is computed in unsigned 128 bits so that `numeric_limits<T>::min()` is
+// rendered correctly.
+template<int Digits, typename T>
+[[nodiscard]] constexpr std::string_view decimal_to_chars(T raw, std::array<char, decimal_max_chars>& buf)
+{
+  auto mag = raw < T{0} ? static_cast<uint128_t>(-static_cast<decimal_wide_t>(raw)) : static_cast<uint128_t>(raw);
+  std::size_t pos = buf.size();
+  int written = 0;
+  do {
+    if (written == Digits && Digits > 0) buf[--pos] = '.';
+    buf[--pos] = static_cast<char>('0' + static_cast<int>(mag % 10u));
+    mag /= 10u;
+    ++written;
+  } while (mag != 0u || written <= Digits);
+  if (raw < T{0}) buf[--pos] = '-';
+  return {buf.data() + pos, buf.size() - pos};
+}
+
+}  // namespace detail
+
+// ============================================================================
+// decimal<T, Digits, RoundingPolicy>
+// ============================================================================
+
+/**
+ * @brief A fixed-exponent decimal number stored as a scaled integer.
+ *
+ * The value is kept as an integer count of `10^-Digits` steps, so decimal fractions such as
+ * cents are represented exactly and additive arithmetic is plain integer arithmetic. Products,
+ * quotients, and unit rescalings are computed in 128-bit intermediates and rounded once,
+ * according to `RoundingPolicy`, when narrowed back to `T`.
+ *
+ * Unit conversions go through the magnitude-aware `operator*(decimal, UnitMagnitude)`
+ * customization point: integral and rational magnitudes are applied as an exact integer
+ * multiply/divide pair (the decomposition used by the built-in integer scaling path), with the
+ * final division rounded instead of truncated.
+ *
+ * @tparam T               the underlying signed integral storage type (e.g. `std::int64_t`)
+ * @tparam Digits          the number of decimal fractional digits
+ * @tparam RoundingPolicy  how inexact results are rounded — default: `round_half_even`
+ */
+MP_UNITS_EXPORT template<std::signed_integral T, int Digits, DecimalRoundingPolicy RoundingPolicy>
+  requires(Digits >= 0 && Digits <= std::numeric_limits<T>::digits10)
+class decimal {
+  using wide = detail::decimal_wide_t;
+
+  [[nodiscard]] static constexpr wide round_div(wide num, wide den)
+  {
+    return detail::rounded_div<RoundingPolicy>(num, den);
+  }
+public:
+  // public members required to satisfy structural type requirements :-(
+  T value_{};
+  using value_type = T;
+  using rounding_policy = RoundingPolicy;
+  static constexpr int digits = Digits;
+  static constexpr T scale_factor = static_cast<T>(detail::pow10(Digits));
+
+  [[nodiscard]] decimal() = default;
+
+  template<detail::integral U>
+  [[nodiscard]] constexpr decimal(U v) :
+      value_(detail::narrow_decimal<T>(static_cast<wide>(v) * static_cast<wide>(scale_factor)))
+  {
+  }
+
+  template<std::floating_point U>
+  [[nodiscard]] constexpr explicit decimal(U v) :
+      value_(detail::narrow_decimal<T>(
+        detail::rounded_from_floating<RoundingPolicy>(static_cast<long double>(v) * scale_factor)))
+  {
+  }
+
+  template<std::signed_integral U, int D, typename RP>
+    requires(!std::same_as<decimal<U, D, RP>, decimal>)
+  [[nodiscard]] constexpr explicit decimal(const decimal<U, D, RP>& other) :
+      value_(detail::narrow_decimal<T>(rescale_from<D>(other.raw_value())))
+  {
+  }
+
+  /**
+   * @brief Creates a decimal directly from its scaled integer (`value * 10^Digits`).
+   */
+  [[nodiscard]] static constexpr decimal from_raw(T raw) noexcept
+  {
+    decimal d;
+    d.value_ = raw;
+    return d;
+  }
+
+  [[nodiscard]] constexpr T raw_value() const noexcept { return value_; }
+
+  template<std::floating_point U>
+  [[nodiscard]] constexpr explicit operator U() const noexcept
+  {
+    return static_cast<U>(value_) / static_cast<U>(scale_factor);
+  }
+
+  template<detail::integral U>
+  [[nodiscard]] constexpr explicit operator U() const
+  {
+    return static_cast<U>(round_div(value_, scale_factor));
+  }
+
+  // ==========================================================================
+  // Unary operators
+  // ==========================================================================
+
+  [[nodiscard]] constexpr decimal operator+() const noexcept { return *this; }
+  [[nodiscard]] constexpr decimal operator-() const { return from_raw(static_cast<T>(-value_)); }
+
+  // ==========================================================================
+  // Compound assignment operators
+  // ==========================================================================
+
+  constexpr decimal& operator+=(const decimal& rhs)
+  {
+    value_ += rhs.value_;
+    return *this;
+  }
+
+  constexpr decimal& operator-=(const decimal& rhs)
+  {
+    value_ -= rhs.value_;
+    return *this;
+  }
+
+  constexpr decimal& operator*=(const decimal& rhs) { return *this = *this * rhs; }
+  constexpr decimal& operator/=(const decimal& rhs) { return *this = *this / rhs; }
+
+  template<detail::integral U>
+  constexpr decimal& operator*=(U rhs)
+  {
+    return *this = *this * rhs;
+  }
+
+  template<detail::integral U>
+  constexpr decimal& operator/=(U rhs)
+  {
+    return *this = *this / rhs;
+  }
+
+  // ==========================================================================
+  // Binary operators
+  // ==========================================================================
+
+  [[nodiscard]] friend constexpr decimal operator+(const decimal& lhs, const decimal& rhs)
+  {
+    return from_raw(static_cast<T>(lhs.value_ + rhs.value_));
+  }
+
+  [[nodiscard]] friend constexpr decimal operator-(const decimal& lhs, const decimal& rhs)
+  {
+    return from_raw(static_cast<T>(lhs.value_ - rhs.value_));
+  }
+
+  [[nodiscard]] friend constexpr decimal operator*(const decimal& lhs, const decimal& rhs)
+  {
+    return from_raw(detail::narrow_decimal<T>(round_div(static_cast<wide>(lhs.value_) * rhs.value_, scale_factor)));
+  }
+
+  [[nodiscard]] friend constexpr decimal operator/(const decimal& lhs, const decimal& rhs)
+  {
+    MP_UNITS_EXPECTS_DEBUG(rhs.value_ != T{0});
+    const wide num = static_cast<wide>(lhs.value_) * scale_factor;
+    const wide den = rhs.value_;
+    return from_raw(detail::narrow_decimal<T>(den < wide{0} ? round_div(-num, -den) : round_div(num, den)));
+  }
+
+  // Integral scalars: multiplication is exact, division is rounded. These are templates so that
+  // they win over the implicit conversion to `decimal` (which would scale the scalar first).
+  template<detail::integral U>
+  [[nodiscard]] friend constexpr decimal operator*(const decimal& lhs, U rhs)
+  {
+    return from_raw(detail::narrow_decimal<T>(static_cast<wide>(lhs.value_) * static_cast<wide>(rhs)));
+  }
+
+  template<detail::integral U>
+  [[nodiscard]] friend constexpr decimal operator*(U lhs, const decimal& rhs)
+  {
+    return rhs * lhs;
+  }
+
+  template<detail::integral U>
+  [[nodiscard]] friend constexpr decimal operator/(const decimal& lhs, U rhs)
+  {
+    MP_UNITS_EXPECTS_DEBUG(rhs != U{0});
+    const auto den = static_cast<wide>(rhs);
+    const auto num = static_cast<wide>(lhs.value_);
+    return from_raw(detail::narrow_decimal<T>(den < wide{0} ? round_div(-num, -den) : round_div(num, den)));
+  }
+
+  template<detail::integral U>
+  [[nodiscard]] friend constexpr decimal operator/(U lhs, const decimal& rhs)
+  {
+    return decimal(lhs) / rhs;
+  }
+
+  // Magnitude-aware scaling customization point (see `mp_units::scale`). Uses the same
+  // integral / inverse-integral / rational decomposition as the built-in integer path, but rounds
+  // the final division with `RoundingPolicy`. Irrational magnitudes (e.g. `π`) can only be
+  // approximated; they go through `long double` and are rounded once.
+  template<UnitMagnitude M>
+  [[nodiscard]] friend constexpr decimal operator*(const decimal& lhs, M)
+  {
+    constexpr M m{};
+    const auto v = static_cast<wide>(lhs.value_);
+    if constexpr (is_integral(m)) {
+      constexpr wide mul = get_value<wide>(m);
+      return from_raw(detail::narrow_decimal<T>(v * mul));
+    } else if constexpr (is_integral(pow<-1>(m))) {
+      constexpr wide div = get_value<wide>(pow<-1>(m));
+      return from_raw(detail::narrow_decimal<T>(round_div(v, div)));
+    } else if constexpr (is_integral(m * (denominator(m) / numerator(m)))) {
+      constexpr wide num = get_value<wide>(numerator(m));
+      constexpr wide den = get_value<wide>(denominator(m));
+      return from_raw(detail::narrow_decimal<T>(round_div(v * num, den)));
+    } else {
+      constexpr long double ratio = get_value<long double>(m);
+      return from_raw(detail::narrow_decimal<T>(
+        detail::rounded_from_floating<RoundingPolicy>(static_cast<long double>(lhs.value_) * ratio)));
+    }
+  }
+
+  // ==========================================================================
+  // Comparisons
+  // ==========================================================================
+
+  [[nodiscard]] friend constexpr bool operator==(const decimal& lhs, const decimal& rhs) noexcept = default;
+
+  [[nodiscard]] friend constexpr std::strong_ordering operator<=>(const decimal& lhs, const decimal& rhs) noexcept
+  {
+    return lhs.value_ <=> rhs.value_;
+  }
+
+  // Compared in 128 bits so that a large integral operand is not overflowed by the scaling.
+  template<std::integral U>
+  [[nodiscard]] friend constexpr bool operator==(const decimal& lhs, U rhs) noexcept
+  {
+    return static_cast<wide>(lhs.value_) == static_cast<wide>(rhs) * scale_factor;
+  }
+
+  template<std::integral U>
+  [[nodiscard]] friend constexpr std::strong_ordering operator<=>(const decimal& lhs, U rhs) noexcept
+  {
+    const auto l = static_cast<wide>(lhs.value_);
+    const auto r = static_cast<wide>(rhs) * scale_factor;
+    if (l < r) return std::strong_ordering::less;
+    if (l > r) return std::strong_ordering::greater;
+    return std::strong_ordering::equal;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const decimal& v)
+  {
+    std::array<char, detail::decimal_max_chars> buf;
+    return os << detail::decimal_to_chars<Digits>(v.value_, buf);
+  }
+
+private:
+  template<int FromDigits, typename U>
+  [[nodiscard]] static constexpr wide rescale_from(U raw)
+  {
+    if constexpr (FromDigits <= Digits)
+      return static_cast<wide>(raw) * detail::pow10(Digits - FromDigits);
+    else
+      return round_div(static_cast<wide>(raw), detail::pow10(FromDigits - Digits));
+  }
+};
+
+}  // namespace mp_units::utility
+
+// std::numeric_limits specialization — required for representation_values<decimal<...>>
+template<typename T, int Digits, typename RoundingPolicy>
+class std::numeric_limits<mp_units::utility::decimal<T, Digits, RoundingPolicy>> : public std::numeric_limits<T> {
+  using D = mp_units::utility::decimal<T, Digits, RoundingPolicy>;
+public:
+  static constexpr bool is_integer = false;
+  static constexpr bool is_exact = true;
+  static constexpr int radix = 10;
+  static constexpr int digits10 = std::numeric_limits<T>::digits10 - Digits;
+  [[nodiscard]] static constexpr D lowest() noexcept { return D::from_raw(std::numeric_limits<T>::lowest()); }
+  [[nodiscard]] static constexpr D min() noexcept { return D::from_raw(std::numeric_limits<T>::min()); }
+  [[nodiscard]] static constexpr D max() noexcept { return D::from_raw(std::numeric_limits<T>::max()); }
+  [[nodiscard]] static constexpr D epsilon() noexcept { return D::from_raw(T{1}); }
+  [[nodiscard]] static constexpr D round_error() noexcept { return D::from_raw(D::scale_factor / 2); }
+  [[nodiscard]] static constexpr D infinity() noexcept { return D{}; }
+  [[nodiscard]] static constexpr D quiet_NaN() noexcept { return D{}; }
+  [[nodiscard]] static constexpr D signaling_NaN() noexcept { return D{}; }
+  [[nodiscard]] static constexpr D denorm_min() noexcept { return D{}; }
+};
+
+template<typename T, int Digits, typename RoundingPolicy, typename Char>
+struct MP_UNITS_STD_FMT::formatter<mp_units::utility::decimal<T, Digits, RoundingPolicy>, Char> :
+    formatter<std::basic_string_view<Char>, Char> {
+  template<typename FormatContext>
+  auto format(const mp_units::utility::decimal<T, Digits, RoundingPolicy>& v, FormatContext& ctx) const
+  {
+    std::array<char, mp_units::utility::detail::decimal_max_chars> buf;
+    const std::string_view txt = mp_units::utility::detail::decimal_to_chars<Digits>(v.raw_value(), buf);
+    std::array<Char, mp_units::utility::detail::decimal_max_chars> out{};
+    for (std::size_t i = 0; i < txt.size(); ++i) out[i] = static_cast<Char>(txt[i]);
+    return formatter<std::basic_string_view<Char>, Char>::format(std::basic_string_view<Char>(out.data(), txt.size()),
+                                                                 ctx);
+  }
+};
@@ -0,0 +1,426 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#endif
+#endif
+
+namespace mp_units::utility {
+
+namespace detail {
+
+template<typename U, typename T>
+concept DualScalar = std::is_arithmetic_v<U> && std::convertible_to<U, T>;
+
+// The tangent updates of every operation have one of the two forms below (the chain rule of a
+// unary or binary function). Both are a single loop over `N` with no dependencies between
+// iterations, which the compilers vectorize for the fixed `N` of `std::array`.
+
+// res[i] = a * x[i]
+template<typename T, std::size_t N>
+[[nodiscard]] constexpr std::array<T, N> scaled_tangents(const T& a, const std::array<T, N>& x)
+{
+  std::array<T, N> res;
+  for (std::size_t i = 0; i < N; ++i) res[i] = a * x[i];
+  return res;
+}
+
+// res[i] = a * x[i] + b * y[i]
+template<typename T, std::size_t N>
+[[nodiscard]] constexpr std::array<T, N> combined_tangents(const T& a, const std::array<T, N>& x, const T& b,
+                                                           const std::array<T, N>& y)
+{
+  std::array<T, N> res;
+  for (std::size_t i = 0; i < N; ++i) res[i] = a * x[i] + b * y[i];
+  return res;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A dual number for forward-mode automatic differentiation.
+ *
+ * Stores a value together with `N` tangents (the partial derivatives of the value with respect
+ * to `N` independent variables) in a contiguous array. Every arithmetic operation and math
+ * function applies the chain rule to all the tangents at once, so evaluating a model with
+ * `dual<double, N>` numbers computes its value and its gradient in a single pass.
+ *
+ * `dual` satisfies `RepresentationOf` for scalar quantities, so the whole model stays
+ * unit-checked. The partial derivatives of a `quantity<R, dual<T, N>>` are expressed in
+ * `R` per unit of the respective independent variable.
+ *
+ * The math functions are provided as hidden friends found by ADL, so the quantity overloads
+ * from `<mp-units/math.h>`, `<mp-units/systems/si/math.h>`, and `<mp-units/systems/angular/math.h>`
+ * work out of the box.
+ *
+ * Comparisons only consider the value, as the control flow of a differentiated function has
+ * to follow the evaluated point.
+ *
+ * **Example:**
+ * @code
+ * using d2 = dual<double, 2>;
+ * quantity m = d2::variable(2.0, 0) * kg;    // ∂/∂m
+ * quantity v = d2::variable(3.0, 1) * m / s; // ∂/∂v
+ * quantity e = m * pow<2>(v) / 2;            // 9 J, ∂E/∂m = 4.5 J/kg, ∂E/∂v = 6 J/(m/s)
+ * @endcode
+ *
+ * @tparam T  the floating-point type of the value and the tangents
+ * @tparam N  the number of independent variables
+ */
+MP_UNITS_EXPORT template<std::floating_point T, std::size_t N>
+  requires(N > 0)
+class dual {
+  T value_{};
+  std::array<T, N> tangents_{};
+
+public:
+  using value_type = T;
+  static constexpr std::size_t size = N;
+
+  dual() = default;
+
+  /**
+   * @brief A constant (all the tangents are zero).
+   */
+  template<detail::DualScalar<T> U>
+  constexpr dual(U value) : value_(static_cast<T>(value))  // NOLINT(google-explicit-constructor)
+  {
+  }
+
+  constexpr dual(T value, const std::array<T, N>& tangents) : value_(value), tangents_(tangents) {}
+
+  /**
+   * @brief The independent variable number `index` (its own tangent is one).
+   */
+  [[nodiscard]] static constexpr dual variable(T value, std::size_t index)
+  {
+    dual res(value);
+    res.tangents_[index] = T{1};
+    return res;
+  }
+
+  [[nodiscard]] constexpr const T& value() const noexcept { return value_; }
+  [[nodiscard]] constexpr const std::array<T, N>& tangents() const noexcept { return tangents_; }
+
+  /**
+   * @brief The partial derivative with respect to the independent variable number `index`.
+   */
+  [[nodiscard]] constexpr const T& tangent(std::size_t index) const { return tangents_[index]; }
+
+  [[nodiscard]] constexpr dual operator+() const { return *this; }
+  [[nodiscard]] constexpr dual operator-() const { return {-value_, detail::scaled_tangents(T{-1}, tangents_)}; }
+
+  constexpr dual& operator+=(const dual& other)
+  {
+    value_ += other.value_;
+    for (std::size_t i = 0; i < N; ++i) tangents_[i] += other.tangents_[i];
+    return *this;
+  }
+
+  constexpr dual& operator-=(const dual& other)
+  {
+    value_ -= other.value_;
+    for (std::size_t i = 0; i < N; ++i) tangents_[i] -= other.tangents_[i];
+    return *this;
+  }
+
+  constexpr dual& operator*=(const dual& other) { return *this = *this * other; }
+  constexpr dual& operator/=(const dual& other) { return *this = *this / other; }
+
+  [[nodiscard]] friend constexpr dual operator+(dual lhs, const dual& rhs) { return lhs += rhs; }
+  [[nodiscard]] friend constexpr dual operator-(dual lhs, const dual& rhs) { return lhs -= rhs; }
+
+  [[nodiscard]] friend constexpr dual operator*(const dual& lhs, const dual& rhs)
+  {
+    return {lhs.value_ * rhs.value_, detail::combined_tangents(rhs.value_, lhs.tangents_, lhs.value_, rhs.tangents_)};
+  }
+
+  [[nodiscard]] friend constexpr dual operator/(const dual& lhs, const dual& rhs)
+  {
+    const T inv = T{1} / rhs.value_;
+    const T value = lhs.value_ * inv;
+    return {value, detail::combined_tangents(inv, lhs.tangents_, -value * inv, rhs.tangents_)};
+  }
+
+  // scalars are constants, so they only scale the tangents (if at all)
+  template<detail::DualScalar<T> U>
+  [[nodiscard]] friend constexpr dual operator+(dual lhs, U rhs)
+  {
+    lhs.value_ += static_cast<T>(rhs);
+    return lhs;
+  }
+
+  template<detail::DualScalar<T> U>
+  [[nodiscard]] friend constexpr dual operator+(U lhs, dual rhs)
+  {
+    rhs.value_ += static_cast<T>(lhs);
+    return rhs;
+  }
+
+  template<detail::DualScalar<T> U>
+  [[nodiscard]] friend constexpr dual operator-(dual lhs, U rhs)
+  {
+    lhs.value_ -= static_cast<T>(rhs);
+    return lhs;
+  }
+
+  template<detail::DualScalar<T> U>
+  [[nodiscard]] friend constexpr dual operator-(U lhs, const dual& rhs)
+  {
+    return {static_cast<T>(lhs) - rhs.value_, detail::scaled_tangents(T{-1}, rhs.tangents_)};
+  }
+
+  template<detail::DualScalar<T> U>
+  [[nodiscard]] friend constexpr dual operator*(const dual& lhs, U rhs)
+  {
+    const auto k = static_cast<T>(rhs);
+    return {lhs.value_ * k, detail::scaled_tangents(k, lhs.tangents_)};
+  }
+
+  template<detail::DualScalar<T> U>
+  [[nodiscard]] friend constexpr dual operator*(U lhs, const dual& rhs)
+  {
+    return rhs * lhs;
+  }
+
+  template<detail::DualScalar<T> U>
+  [[nodiscard]] friend constexpr dual operator/(const dual& lhs, U rhs)
+  {
+    const T inv = T{1} / static_cast<T>(rhs);
+    return {lhs.value_ * inv, detail::scaled_tangents(inv, lhs.tangents_)};
+  }
+
+  template<detail::DualScalar<T> U>
+  [[nodiscard]] friend constexpr dual operator/(U lhs, const dual& rhs)
+  {
+    const T value = static_cast<T>(lhs) / rhs.value_;
+    return {value, detail::scaled_tangents(-value / rhs.value_, rhs.tangents_)};
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const dual& lhs, const dual& rhs) noexcept
+  {
+    return lhs.value_ == rhs.value_;
+  }
+
+  [[nodiscard]] friend constexpr auto operator<=>(const dual& lhs, const dual& rhs) noexcept
+  {
+    return lhs.value_ <=> rhs.value_;
+  }
+
+  template<detail::DualScalar<T> U>
+  [[nodiscard]] friend constexpr bool operator==(const dual& lhs, U rhs) noexcept
+  {
+    return lhs.value_ == static_cast<T>(rhs);
+  }
+
+  template<detail::DualScalar<T> U>
+  [[nodiscard]] friend constexpr auto operator<=>(const dual& lhs, U rhs) noexcept
+  {
+    return lhs.value_ <=> static_cast<T>(rhs);
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const dual& v)
+  {
+    os << v.value_ << " [";
+    for (std::size_t i = 0; i < N; ++i) os << (i ? ", " : "") << v.tangents_[i];
+    return os << ']';
+  }
+
+  // ==========================================================================
+  // Math functions (found by ADL from the quantity overloads)
+  // ==========================================================================
+
+  [[nodiscard]] friend constexpr dual abs(const dual& v) { return v.value_ < T{} ? -v : v; }
+
+  /// @note Formula: ∂(xʸ)/∂x = y × xʸ⁻¹
+  [[nodiscard]] friend dual pow(const dual& base, T exponent)
+  {
+    using std::pow;
+    const T value = pow(base.value_, exponent);
+    return base.chain(value, exponent * pow(base.value_, exponent - T{1}));
+  }
+
+  /// @note Formula: ∂(xʸ) = xʸ × (y/x × ∂x + ln(x) × ∂y)
+  [[nodiscard]] friend dual pow(const dual& base, const dual& exponent)
+  {
+    using std::log, std::pow;
+    const T value = pow(base.value_, exponent.value_);
+    return {value, detail::combined_tangents(exponent.value_ * value / base.value_, base.tangents_,
+                                             value * log(base.value_), exponent.tangents_)};
+  }
+
+  /// @note Formula: ∂√x/∂x = 1 / (2√x)
+  [[nodiscard]] friend dual sqrt(const dual& v)
+  {
+    using std::sqrt;
+    const T value = sqrt(v.value_);
+    return v.chain(value, T{1} / (T{2} * value));
+  }
+
+  /// @note Formula: ∂∛x/∂x = 1 / (3∛x²)
+  [[nodiscard]] friend dual cbrt(const dual& v)
+  {
+    using std::cbrt;
+    const T value = cbrt(v.value_);
+    return v.chain(value, T{1} / (T{3} * value * value));
+  }
+
+  /// @note Formula: ∂eˣ/∂x = eˣ
+  [[nodiscard]] friend dual exp(const dual& v)
+  {
+    using std::exp;
+    const T value = exp(v.value_);
+    return v.chain(value, value);
+  }
+
+  /// @note Formula: ∂ln(x)/∂x = 1/x
+  [[nodiscard]] friend dual log(const dual& v)
+  {
+    using std::log;
+    return v.chain(log(v.value_), T{1} / v.value_);
+  }
+
+  /// @note Formula: ∂√(x² + y²) = (x × ∂x + y × ∂y) / √(x² + y²)
+  [[nodiscard]] friend dual hypot(const dual& x, const dual& y)
+  {
+    using std::hypot;
+    const T value = hypot(x.value_, y.value_);
+    const T inv = value == T{} ? T{} : T{1} / value;
+    return {value, detail::combined_tangents(x.value_ * inv, x.tangents_, y.value_ * inv, y.tangents_)};
+  }
+
+  /// @note Formula: ∂(a × x + b) = x × ∂a + a × ∂x + ∂b
+  [[nodiscard]] friend dual fma(const dual& a, const dual& x, const dual& b)
+  {
+    using std::fma;
+    std::array<T, N> tangents;
+    for (std::size_t i = 0; i < N; ++i)
+      tangents[i] = x.value_ * a.tangents_[i] + a.value_ * x.tangents_[i] + b.tangents_[i];
+    return {fma(a.value_, x.value_, b.value_), tangents};
+  }
+
+  [[nodiscard]] friend dual sin(const dual& v)
+  {
+    using std::cos, std::sin;
+    return v.chain(sin(v.value_), cos(v.value_));
+  }
+
+  [[nodiscard]] friend dual cos(const dual& v)
+  {
+    using std::cos, std::sin;
+    return v.chain(cos(v.value_), -sin(v.value_));
+  }
+
+  /// @note Formula: ∂tan(x)/∂x = 1 + tan²(x)
+  [[nodiscard]] friend dual tan(const dual& v)
+  {
+    using std::tan;
+    const T value = tan(v.value_);
+    return v.chain(value, T{1} + value * value);
+  }
+
+  /// @note Formula: ∂asin(x)/∂x = 1 / √(1 - x²)
+  [[nodiscard]] friend dual asin(const dual& v)
+  {
+    using std::asin, std::sqrt;
+    return v.chain(asin(v.value_), T{1} / sqrt(T{1} - v.value_ * v.value_));
+  }
+
+  /// @note Formula: ∂acos(x)/∂x = -1 / √(1 - x²)
+  [[nodiscard]] friend dual acos(const dual& v)
+  {
+    using std::acos, std::sqrt;
+    return v.chain(acos(v.value_), T{-1} / sqrt(T{1} - v.value_ * v.value_));
+  }
+
+  /// @note Formula: ∂atan(x)/∂x = 1 / (1 + x²)
+  [[nodiscard]] friend dual atan(const dual& v)
+  {
+    using std::atan;
+    return v.chain(atan(v.value_), T{1} / (T{1} + v.value_ * v.value_));
+  }
+
+  /// @note Formula: ∂atan2(y, x) = (x × ∂y - y × ∂x) / (x² + y²)
+  [[nodiscard]] friend dual atan2(const dual& y, const dual& x)
+  {
+    using std::atan2;
+    const T inv = T{1} / (x.value_ * x.value_ + y.value_ * y.value_);
+    return {atan2(y.value_, x.value_),
+            detail::combined_tangents(x.value_ * inv, y.tangents_, -y.value_ * inv, x.tangents_)};
+  }
+
+  // piecewise constant functions have zero derivatives (almost everywhere)
+  [[nodiscard]] friend dual floor(const dual& v)
+  {
+    using std::floor;
+    return floor(v.value_);
+  }
+
+  [[nodiscard]] friend dual ceil(const dual& v)
+  {
+    using std::ceil;
+    return ceil(v.value_);
+  }
+
+  [[nodiscard]] friend bool isfinite(const dual& v)
+  {
+    using std::isfinite;
+    return isfinite(v.value_);
+  }
+
+  [[nodiscard]] friend bool isinf(const dual& v)
+  {
+    using std::isinf;
+    return isinf(v.value_);
+  }
+
+  [[nodiscard]] friend bool isnan(const dual& v)
+  {
+    using std::isnan;
+    return isnan(v.value_);
+  }
+
+private:
+  // the result of `f(*this)` where `f(value_) == value` and `f'(value_) == derivative`
+  [[nodiscard]] constexpr dual chain(T value, T derivative) const
+  {
+    return {value, detail::scaled_tangents(derivative, tangents_)};
+  }
+};
+
+}  // namespace mp_units::utility
@@ -0,0 +1,169 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/compat_macros.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/quantity_spec.h>
+#include <mp-units/framework/unit.h>
+#include <mp-units/utility/bits/sharding.h>
+#include <mp-units/utility/bits/unit_index.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+#endif
+#endif
+
+namespace mp_units::utility {
+
+/**
+ * @brief A runtime table of conversion rates between units of one quantity kind.
+ *
+ * Some units of the same kind are not related by a compile-time magnitude (currencies are the
+ * canonical example): the factor between them is only known at runtime and changes while the
+ * program runs. `exchange_rate_table` stores those factors in a dense `N×N` matrix indexed by the
+ * position of a unit in `Us...`, so a lookup is a single indexed load.
+ *
+ * Every rate is an independent `std::atomic<double>` and each row is aligned to a cache line.
+ * A conversion needs exactly one rate, so readers never retry: `rate()` and `convert()` are
+ * wait-free and see either the previous or the new value of a concurrently updated entry. A
+ * writer publishing a new rate does not block readers of other rows.
+ *
+ * Rates that were never set are NaN, so converting through a missing quote is visible in the
+ * result rather than silently producing zero. The diagonal is always `1`.
+ *
+ * @tparam QS  the quantity kind the units belong to (e.g. `currency`)
+ * @tparam Us  the units the table converts between (e.g. `euro, us_dollar, japanese_jen`)
+ */
+MP_UNITS_EXPORT template<QuantitySpec auto QS, Unit auto... Us>
+  requires(sizeof...(Us) > 0) && (UnitOf<MP_UNITS_REMOVE_CONST(decltype(Us)), QS> && ...)
+class exchange_rate_table {
+  struct alignas(detail::cache_line_size) row {
+    std::array<std::atomic<double>, sizeof...(Us)> rates;
+  };
+  std::array<row, sizeof...(Us)> rows_;
+
+  template<auto U>
+  static constexpr bool contains = detail::unit_index_of<U, Us...>() < sizeof...(Us);
+public:
+  using rate_type = double;
+  static constexpr std::size_t size = sizeof...(Us);
+
+  exchange_rate_table() noexcept
+  {
+    for (std::size_t from = 0; from < size; ++from)
+      for (std::size_t to = 0; to < size; ++to)
+        rows_[from].rates[to].store(from == to ? 1.0 : std::numeric_limits<double>::quiet_NaN(),
+                                    std::memory_order_relaxed);
+  }
+
+  exchange_rate_table(const exchange_rate_table&) = delete;
+  exchange_rate_table& operator=(const exchange_rate_table&) = delete;
+
+  /**
+   * @brief The position of a unit in the table (its runtime id).
+   */
+  template<Unit U>
+    requires contains<U{}>
+  [[nodiscard]] static consteval std::size_t index_of(U)
+  {
+    return detail::unit_index_of<U{}, Us...>();
+  }
+
+  // ==========================================================================
+  // Runtime-indexed access
+  // ==========================================================================
+
+  [[nodiscard]] rate_type rate(std::size_t from, std::size_t to) const noexcept
+  {
+    MP_UNITS_EXPECTS_DEBUG(from < size && to < size);
+    return rows_[from].rates[to].load(std::memory_order_acquire);
+  }
+
+  void set_rate(std::size_t from, std::size_t to, rate_type value) noexcept
+  {
+    MP_UNITS_EXPECTS_DEBUG(from < size && to < size && from != to);
+    rows_[from].rates[to].store(value, std::memory_order_release);
+  }
+
+  // ==========================================================================
+  // Unit-typed access
+  // ==========================================================================
+
+  template<Unit From, Unit To>
+    requires contains<From{}> && contains<To{}>
+  [[nodiscard]] rate_type rate(From from, To to) const noexcept
+  {
+    return rate(index_of(from), index_of(to));
+  }
+
+  template<Unit From, Unit To>
+    requires contains<From{}> && contains<To{}> && (!std::is_same_v<From, To>)
+  void set_rate(From from, To to, rate_type value) noexcept
+  {
+    set_rate(index_of(from), index_of(to), value);
+  }
+
+  /**
+   * @brief Converts a quantity to the unit `To` with the current rate.
+   *
+   * @tparam To     the target unit
+   * @tparam ToRep  the representation type of the result
+   */
+  template<Unit auto To, typename ToRep = rate_type, QuantityOf<QS> Q>
+    requires contains<To> && contains<Q::unit>
+  [[nodiscard]] quantity<Q::quantity_spec[To], ToRep> convert(const Q& q) const noexcept
+  {
+    const rate_type r = rate(index_of(Q::unit), index_of(To));
+    return static_cast<ToRep>(static_cast<rate_type>(q.numerical_value_in(Q::unit)) * r) * Q::quantity_spec[To];
+  }
+
+  /**
+   * @brief Converts a batch of quantities to the unit of the output elements.
+   *
+   * The rate is read once for the whole batch, so the output is consistent even if the rate is
+   * updated concurrently, and the loop body is a plain multiply the compiler can vectorize.
+   */
+  template<QuantityOf<QS> Q, QuantityOf<QS> QTo, std::size_t E1, std::size_t E2>
+    requires contains<Q::unit> && contains<QTo::unit>
+  void convert(std::span<const Q, E1> from, std::span<QTo, E2> to) const noexcept
+  {
+    MP_UNITS_EXPECTS(from.size() <= to.size());
+    const rate_type r = rate(index_of(Q::unit), index_of(QTo::unit));
+    for (std::size_t i = 0; i < from.size(); ++i)
+      to[i] = static_cast<QTo::rep>(static_cast<rate_type>(from[i].numerical_value_in(Q::unit)) * r) * QTo::reference;
+  }
+};
+
+}  // namespace mp_units::utility
@@ -0,0 +1,327 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/quantity_point.h>
+#include <mp-units/utility/column_codec.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <span>
+#include <stdexcept>
+#include <streambuf>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#endif
+
+#if __has_include(<sys/mman.h>)
+#define MP_UNITS_HAS_MMAP 1
+#else
+#define MP_UNITS_HAS_MMAP 0
+#endif
+
+#if MP_UNITS_HAS_MMAP
+
+namespace mp_units::utility {
+
+namespace detail {
+
+// reads the header of a column file straight from its mapping
+class mapped_column_buf : public std::streambuf {
+public:
+  mapped_column_buf(const std::byte* data, std::size_t size)
+  {
+    char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+    setg(begin, begin, begin + size);
+  }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+  {
+    if (dir != std::ios_base::cur || off != 0) return pos_type(off_type(-1));
+    return pos_type(gptr() - eback());
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief The expected access pattern of a mapped column (forwarded to `madvise`)
+ */
+MP_UNITS_EXPORT enum class column_access : std::uint8_t { normal, sequential, random };
+
+/**
+ * @brief One column of a column file (see `write_columns`) mapped into memory as values of `T`
+ *
+ * The file is mapped read-only when the column is opened and its header is validated against `T`
+ * (see `column_conversion`), so a file of another dimension, reference unit or origin is rejected
+ * up front rather than misread.
+ *
+ * If the column is stored in the unit and representation type of `T` (and the platform is
+ * little-endian), `values()` exposes the mapping in place as `std::span<const T>`, without reading
+ * or copying anything. Otherwise, the values are converted lazily: `operator[]` converts a single
+ * value and `for_each_chunk()` converts one chunk at a time into a small buffer.
+ *
+ * The mapping is private to the object, which is movable but not copyable.
+ */
+MP_UNITS_EXPORT template<ColumnElement T>
+class mapped_quantity_column {
+  using rep = T::rep;
+  using loader = void (*)(const std::byte*, std::size_t, const column_conversion&, T*);
+
+  const std::byte* map_ = nullptr;
+  std::size_t map_size_ = 0;
+  column_header header_;
+  column_conversion conversion_{};
+  loader load_ = nullptr;
+
+  [[nodiscard]] static T make(rep v)
+  {
+    if constexpr (Quantity<T>)
+      return T{v, T::reference};
+    else
+      return T{v * T::reference, T::point_origin};
+  }
+
+  // converts `n` values stored as `Rep` (selected once, when the column is opened)
+  template<typename Rep>
+  static void load(const std::byte* p, std::size_t n, const column_conversion& conv, T* out)
+  {
+    for (std::size_t i = 0; i < n; ++i, p += sizeof(Rep)) {
+      Rep v;
+      std::memcpy(&v, p, sizeof(Rep));
+      out[i] = make(detail::scale_column_value<rep>(detail::to_little_endian(v), conv));
+    }
+  }
+
+  [[nodiscard]] const std::byte* data() const noexcept { return map_ + header_.offset; }
+
+  void advise(const std::byte* first, std::size_t size, int advice) const noexcept
+  {
+    // `madvise` requires a page-aligned address; the hint is best-effort, so failures are ignored
+    const auto page = page_size();
+    const auto begin = reinterpret_cast<std::uintptr_t>(first) / page * page;
+    const auto end = reinterpret_cast<std::uintptr_t>(first) + size;
+    if (end > begin) ::madvise(reinterpret_cast<void*>(begin), end - begin, advice);
+  }
+
+  void unmap() noexcept
+  {
+    if (map_) ::munmap(const_cast<std::byte*>(map_), map_size_);
+    map_ = nullptr;
+  }
+
+public:
+  using value_type = T;
+
+  /**
+   * @brief Maps the column `index` of the file at `path`
+   *
+   * Throws `std::system_error` if the file cannot be mapped, `std::runtime_error` if it is not a
+   * valid column file, and `std::invalid_argument` if the column cannot be read as `T`.
+   */
+  explicit mapped_quantity_column(const std::filesystem::path& path, std::size_t index = 0)
+  {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "cannot open '" + path.string() + "'");
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+      const int err = errno;
+      ::close(fd);
+      throw std::system_error(err, std::generic_category(), "cannot stat '" + path.string() + "'");
+    }
+    map_size_ = static_cast<std::size_t>(st.st_size);
+    if (map_size_ > 0) {
+      void* p = ::mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      const int err = errno;
+      ::close(fd);
+      if (p == MAP_FAILED) throw std::system_error(err, std::generic_category(), "cannot map '" + path.string() + "'");
+      map_ = static_cast<const std::byte*>(p);
+    } else
+      ::close(fd);
+
+    try {
+      detail::mapped_column_buf buf(map_, map_size_);
+      std::istream is(&buf);
+      header_ = column_reader(is).columns().at(index);
+      if (header_.offset + header_.size * header_.rep_size > map_size_)
+        throw std::runtime_error("truncated column file");
+      conversion_ = column_conversion::to<T>(header_);
+      if constexpr (std::endian::native != std::endian::little) conversion_.as_is = false;
+      load_ = detail::visit_column_rep(header_, [](auto id) -> loader { return &load<typename decltype(id)::type>; });
+    } catch (...) {
+      unmap();
+      throw;
+    }
+  }
+
+  mapped_quantity_column(mapped_quantity_column&& other) noexcept :
+      map_(std::exchange(other.map_, nullptr)),
+      map_size_(std::exchange(other.map_size_, 0)),
+      header_(std::exchange(other.header_, {})),
+      conversion_(other.conversion_),
+      load_(other.load_)
+  {
+    other.conversion_.as_is = false;
+  }
+
+  mapped_quantity_column& operator=(mapped_quantity_column&& other) noexcept
+  {
+    if (this != &other) {
+      unmap();
+      map_ = std::exchange(other.map_, nullptr);
+      map_size_ = std::exchange(other.map_size_, 0);
+      header_ = std::exchange(other.header_, {});
+      conversion_ = other.conversion_;
+      load_ = other.load_;
+      other.conversion_.as_is = false;
+    }
+    return *this;
+  }
+
+  ~mapped_quantity_column() { unmap(); }
+
+  [[nodiscard]] static std::size_t page_size() noexcept
+  {
+    static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  [[nodiscard]] const column_header& header() const noexcept { return header_; }
+  [[nodiscard]] std::size_t size() const noexcept { return static_cast<std::size_t>(header_.size); }
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Whether the mapping holds values of `T` as they are, so `values()` may be used
+   */
+  [[nodiscard]] bool in_place() const noexcept { return conversion_.as_is; }
+
+  /**
+   * @brief The mapped values, without a copy
+   *
+   * @pre `in_place()`
+   */
+  [[nodiscard]] std::span<const T> values() const
+  {
+    MP_UNITS_EXPECTS(in_place());
+    return {reinterpret_cast<const T*>(data()), size()};
+  }
+
+  /**
+   * @brief The value at `i`, converted to `T` if needed
+   */
+  [[nodiscard]] T operator[](std::size_t i) const
+  {
+    MP_UNITS_EXPECTS_DEBUG(i < size());
+    if (in_place()) return reinterpret_cast<const T*>(data())[i];
+    T res;
+    load_(data() + i * header_.rep_size, 1, conversion_, &res);
+    return res;
+  }
+
+  /**
+   * @brief Hints the expected access pattern of the whole column to the kernel
+   */
+  void advise(column_access access) const noexcept
+  {
+    const int advice = access == column_access::sequential ? MADV_SEQUENTIAL
+                       : access == column_access::random   ? MADV_RANDOM
+                                                           : MADV_NORMAL;
+    advise(data(), size() * header_.rep_size, advice);
+  }
+
+  /**
+   * @brief Asks the kernel to start reading the pages of the values `[first, first + count)`
+   */
+  void prefetch(std::size_t first, std::size_t count) const noexcept
+  {
+    first = std::min(first, size());
+    count = std::min(count, size() - first);
+    if (count > 0) advise(data() + first * header_.rep_size, count * header_.rep_size, MADV_WILLNEED);
+  }
+
+  /**
+   * @brief Calls `f(std::span<const T>)` for consecutive chunks of the column
+   *
+   * The chunks end on page boundaries of the mapping (`pages_per_chunk` pages each, except for the
+   * first and the last one), and the pages of the next chunk are prefetched before `f` processes the
+   * current one. Values that have to be converted are converted one chunk at a time into a buffer
+   * reused for the whole column.
+   */
+  template<std::invocable<std::span<const T>> F>
+  void for_each_chunk(F&& f, std::size_t pages_per_chunk = 16) const
+  {
+    MP_UNITS_EXPECTS(pages_per_chunk > 0);
+    if (empty()) return;
+    const std::size_t rep_size = header_.rep_size;
+    const std::size_t chunk_bytes = pages_per_chunk * page_size();
+    const auto base = reinterpret_cast<std::uintptr_t>(data());
+    auto chunk_end = [&](std::size_t first) {
+      const std::uintptr_t end = (base + first * rep_size) / chunk_bytes * chunk_bytes + chunk_bytes;
+      return std::min(size(), std::max(first + 1, static_cast<std::size_t>(end - base) / rep_size));
+    };
+
+    std::vector<T> buffer;
+    if (!in_place()) buffer.resize(std::min(size(), chunk_bytes / rep_size + 1));
+    for (std::size_t first = 0; first < size();) {
+      const std::size_t last = chunk_end(first);
+      prefetch(last, chunk_end(last) - last);
+      if (in_place())
+        f(values().subspan(first, last - first));
+      else {
+        load_(data() + first * rep_size, last - first, conversion_, buffer.data());
+        f(std::span<const T>(buffer.data(), last - first));
+      }
+      first = last;
+    }
+  }
+};
+
+}  // namespace mp_units::utility
+
+#endif  // MP_UNITS_HAS_MMAP
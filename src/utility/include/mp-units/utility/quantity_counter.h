@@ -0,0 +1,135 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/quantity_concepts.h>
+#include <mp-units/framework/value_cast.h>
+#include <mp-units/systems/si/chrono.h>
+#include <mp-units/systems/si/units.h>
+#include <mp-units/utility/atomic_quantity.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <mutex>
+#endif
+#endif
+
+namespace mp_units::utility {
+
+/**
+ * @brief A high-contention counter with rate reporting
+ *
+ * Updates go to a per-thread, cache-line-padded shard (see `sharded_atomic_quantity`), so
+ * writers on different cores never contend; the shards are folded together only when the
+ * counter is read. `rate()` returns the throughput since its previous call, measured with
+ * `Clock`, e.g. `quantity<iec::byte / si::second>` for a counter of bytes.
+ *
+ * Wrap-around of unsigned representation types is handled by computing the increment of the
+ * total modulo `2^N`, so a counter of `std::uint64_t` bytes never overflows in practice.
+ *
+ * @tparam Q       the counted quantity type (e.g. `quantity<iec::byte, std::uint64_t>`)
+ * @tparam Shards  the number of shards; at least the number of concurrently writing threads
+ * @tparam Clock   the clock used to measure the rate window
+ */
+MP_UNITS_EXPORT template<Quantity Q, std::size_t Shards = 128, typename Clock = std::chrono::steady_clock>
+class quantity_counter {
+  sharded_atomic_quantity<Q, Shards> total_;
+  mutable std::mutex window_mutex_;
+  Q window_total_{};
+  Clock::time_point window_start_;
+public:
+  using value_type = Q;
+  using rep = Q::rep;
+  using clock = Clock;
+  using rate_type = quantity<Q::reference / si::second, double>;
+
+  quantity_counter() : window_start_(Clock::now()) {}
+  explicit quantity_counter(Clock::time_point start) : window_start_(start) {}
+
+  quantity_counter(const quantity_counter&) = delete;
+  quantity_counter& operator=(const quantity_counter&) = delete;
+
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  void add(const Q2& q) noexcept
+  {
+    total_.add(q);
+  }
+
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  quantity_counter& operator+=(const Q2& q) noexcept
+  {
+    add(q);
+    return *this;
+  }
+
+  /**
+   * @brief The sum of all the updates so far
+   */
+  [[nodiscard]] Q total() const noexcept { return total_.load(); }
+
+  /**
+   * @brief The average rate since the previous call (or construction), which starts a new window
+   *
+   * May be called from several threads; calls are serialized with each other but never block
+   * the writers.
+   */
+  [[nodiscard]] rate_type rate(typename Clock::time_point now)
+  {
+    const std::scoped_lock lock(window_mutex_);
+    return close_window(now);
+  }
+
+  [[nodiscard]] rate_type rate()
+  {
+    const std::scoped_lock lock(window_mutex_);
+    return close_window(Clock::now());
+  }
+
+private:
+  // the snapshot of the total is taken under `window_mutex_`, so consecutive windows never
+  // overlap and the modulo delta below cannot wrap to a bogus value
+  [[nodiscard]] rate_type close_window(typename Clock::time_point now)
+  {
+    const Q total = total_.load(std::memory_order_acquire);
+    const Q delta =
+      static_cast<rep>(total.numerical_value_in(Q::unit) - window_total_.numerical_value_in(Q::unit)) * Q::reference;
+    const quantity elapsed = quantity{now - window_start_};
+    window_total_ = total;
+    window_start_ = now;
+    if (elapsed <= elapsed.zero()) return rate_type::zero();
+    return (value_cast<double>(delta) / value_cast<double>(elapsed)).in(rate_type::unit);
+  }
+};
+
+}  // namespace mp_units::utility
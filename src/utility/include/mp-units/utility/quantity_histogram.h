@@ -0,0 +1,265 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/quantity_concepts.h>
+#include <mp-units/utility/bits/sharding.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#endif
+#endif
+
+namespace mp_units::utility {
+
+namespace detail {
+
+/**
+ * @brief Log-linear buckets covering the whole range of an unsigned integer
+ *
+ * Values below `2^(P + 1)` get a bucket each; above that, every power of two is split into `2^P`
+ * equal sub-buckets, so the width of a bucket is at most `1 / 2^P` of the values it holds. The index
+ * is computed with a `bit_width` and a shift, without any floating-point arithmetic.
+ */
+template<std::unsigned_integral T, std::size_t P>
+  requires(P < std::numeric_limits<T>::digits)
+struct log_linear_buckets {
+  static constexpr std::size_t sub_bucket_count = std::size_t{1} << P;
+  static constexpr std::size_t size = (std::numeric_limits<T>::digits - P + 1) * sub_bucket_count;
+
+  [[nodiscard]] static constexpr std::size_t index_of(T v) noexcept
+  {
+    const auto width = static_cast<std::size_t>(std::bit_width(v));
+    if (width <= P + 1) return static_cast<std::size_t>(v);
+    const std::size_t shift = width - P - 1;
+    return (shift + 1) * sub_bucket_count + static_cast<std::size_t>(v >> shift) - sub_bucket_count;
+  }
+
+  // the highest value that falls into the bucket `i`
+  [[nodiscard]] static constexpr T highest_value_of(std::size_t i) noexcept
+  {
+    if (i < 2 * sub_bucket_count) return static_cast<T>(i);
+    const std::size_t shift = i / sub_bucket_count - 1;
+    const auto base = static_cast<T>(sub_bucket_count + i % sub_bucket_count);
+    return static_cast<T>(static_cast<T>(static_cast<T>(base + 1) << shift) - 1);
+  }
+};
+
+}  // namespace detail
+
+MP_UNITS_EXPORT template<Quantity Q, std::size_t Shards, std::size_t SubBucketBits>
+  requires std::integral<typename Q::rep> && (!std::same_as<typename Q::rep, bool>)
+class quantity_histogram;
+
+/**
+ * @brief The counts of a `quantity_histogram` at one moment
+ *
+ * A plain (non-atomic) value that can be stored, merged with the snapshots of other histograms
+ * (e.g. of other processes) and queried for percentiles.
+ *
+ * @tparam Q              the recorded quantity type with an integral representation
+ * @tparam SubBucketBits  every power of two of the raw value is split into `2^SubBucketBits` buckets
+ */
+MP_UNITS_EXPORT template<Quantity Q, std::size_t SubBucketBits = 5>
+  requires std::integral<typename Q::rep> && (!std::same_as<typename Q::rep, bool>)
+class histogram_snapshot {
+public:
+  using value_type = Q;
+  using rep = Q::rep;
+  using buckets = detail::log_linear_buckets<std::make_unsigned_t<rep>, SubBucketBits>;
+
+  /**
+   * @brief Adds `n` occurrences of `q`, which must not be negative
+   */
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  constexpr void record(const Q2& q, std::uint64_t n = 1) noexcept
+  {
+    counts_[bucket_of(q)] += n;
+  }
+
+  /**
+   * @brief The bucket of a value
+   */
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  [[nodiscard]] static constexpr std::size_t bucket_of(const Q2& q) noexcept
+  {
+    const rep v = Q(q).numerical_value_in(Q::unit);
+    MP_UNITS_EXPECTS_DEBUG(v >= rep{});
+    return buckets::index_of(static_cast<std::make_unsigned_t<rep>>(v));
+  }
+
+  [[nodiscard]] constexpr std::uint64_t count() const noexcept
+  {
+    std::uint64_t res = 0;
+    for (const std::uint64_t c : counts_) res += c;
+    return res;
+  }
+
+  [[nodiscard]] constexpr std::uint64_t count_at(std::size_t bucket) const noexcept
+  {
+    MP_UNITS_EXPECTS_DEBUG(bucket < buckets::size);
+    return counts_[bucket];
+  }
+
+  /**
+   * @brief The value below or at which `p` percent of the recorded values fall
+   *
+   * Returns the highest value of the bucket holding the sample of that rank, so the result errs on
+   * the high side by less than the bucket resolution. Requires at least one recorded value.
+   */
+  [[nodiscard]] constexpr Q percentile(double p) const noexcept
+  {
+    MP_UNITS_EXPECTS(p >= 0. && p <= 100.);
+    const std::uint64_t total = count();
+    MP_UNITS_EXPECTS(total > 0);
+    const double exact_rank = p / 100. * static_cast<double>(total);
+    auto rank = static_cast<std::uint64_t>(exact_rank);
+    if (static_cast<double>(rank) < exact_rank || rank < 1) ++rank;
+    if (rank > total) rank = total;
+    std::uint64_t seen = 0;
+    std::size_t i = 0;
+    for (; i < buckets::size - 1; ++i) {
+      seen += counts_[i];
+      if (seen >= rank) break;
+    }
+    const auto v = buckets::highest_value_of(i);
+    const auto max = static_cast<std::make_unsigned_t<rep>>(std::numeric_limits<rep>::max());
+    return Q{static_cast<rep>(v < max ? v : max), Q::reference};
+  }
+
+  constexpr histogram_snapshot& operator+=(const histogram_snapshot& other) noexcept
+  {
+    for (std::size_t i = 0; i < buckets::size; ++i) counts_[i] += other.counts_[i];
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr histogram_snapshot operator+(histogram_snapshot lhs,
+                                                              const histogram_snapshot& rhs) noexcept
+  {
+    return lhs += rhs;
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const histogram_snapshot&, const histogram_snapshot&) = default;
+
+private:
+  template<Quantity Q2, std::size_t Shards, std::size_t SubBucketBits2>
+    requires std::integral<typename Q2::rep> && (!std::same_as<typename Q2::rep, bool>)
+  friend class quantity_histogram;
+
+  std::array<std::uint64_t, buckets::size> counts_{};
+};
+
+/**
+ * @brief A lock-free log-linear histogram of quantities (e.g. request latencies)
+ *
+ * Recording finds the bucket of the raw integral value with integer operations only and increments
+ * a relaxed atomic counter in a per-thread, cache-line-aligned shard, so concurrent writers never
+ * contend as long as there are at least as many shards as writing threads. Readers fold the shards
+ * into a `histogram_snapshot`, which answers percentile queries with quantities of type `Q`.
+ *
+ * With the default `SubBucketBits` of 5 the relative error of a percentile is below 3.2%, and each
+ * shard of a 64-bit representation takes 15 KiB.
+ *
+ * @tparam Q              the recorded quantity type, e.g. `quantity<si::nano<si::second>, std::int64_t>`
+ * @tparam Shards         the number of shards; at least the number of concurrently recording threads
+ * @tparam SubBucketBits  every power of two of the raw value is split into `2^SubBucketBits` buckets
+ */
+MP_UNITS_EXPORT template<Quantity Q, std::size_t Shards = 16, std::size_t SubBucketBits = 5>
+  requires std::integral<typename Q::rep> && (!std::same_as<typename Q::rep, bool>)
+class quantity_histogram {
+public:
+  using value_type = Q;
+  using rep = Q::rep;
+  using snapshot_type = histogram_snapshot<Q, SubBucketBits>;
+  using buckets = snapshot_type::buckets;
+  static constexpr std::size_t shard_count = Shards;
+
+private:
+  struct alignas(detail::cache_line_size) shard {
+    std::array<std::atomic<std::uint64_t>, buckets::size> counts{};
+  };
+  std::array<shard, Shards> shards_{};
+
+public:
+  quantity_histogram() = default;
+  quantity_histogram(const quantity_histogram&) = delete;
+  quantity_histogram& operator=(const quantity_histogram&) = delete;
+
+  /**
+   * @brief Records a value, which must not be negative
+   */
+  template<Quantity Q2>
+    requires std::convertible_to<Q2, Q>
+  void record(const Q2& q) noexcept
+  {
+    shards_[detail::this_thread_shard_id() % Shards].counts[snapshot_type::bucket_of(q)].fetch_add(
+      1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief The sum of all the shards
+   *
+   * Values recorded concurrently with the call may or may not be included.
+   */
+  [[nodiscard]] snapshot_type snapshot() const noexcept
+  {
+    snapshot_type res;
+    for (const shard& s : shards_)
+      for (std::size_t i = 0; i < buckets::size; ++i) res.counts_[i] += s.counts[i].load(std::memory_order_relaxed);
+    return res;
+  }
+
+  /**
+   * @brief Resets all the shards and returns the sum of their previous counts
+   *
+   * Every recorded value is counted by exactly one of the consecutive calls.
+   */
+  snapshot_type exchange_zero() noexcept
+  {
+    snapshot_type res;
+    for (shard& s : shards_)
+      for (std::size_t i = 0; i < buckets::size; ++i)
+        res.counts_[i] += s.counts[i].exchange(0, std::memory_order_relaxed);
+    return res;
+  }
+};
+
+}  // namespace mp_units::utility
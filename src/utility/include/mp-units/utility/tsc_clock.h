@@ -0,0 +1,150 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/compat_macros.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/quantity_point.h>
+#include <mp-units/framework/quantity_spec.h>
+#include <mp-units/framework/unit.h>
+#include <mp-units/systems/isq/base_quantities.h>
+#include <mp-units/systems/si/chrono.h>
+#include <mp-units/systems/si/prefixes.h>
+#include <mp-units/systems/si/units.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <chrono>
+#include <cstdint>
+#endif
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) || defined(__x86_64__) || defined(__i386__) || \
+  defined(__aarch64__)
+#define MP_UNITS_HAS_TSC 1
+#else
+#define MP_UNITS_HAS_TSC 0
+#endif
+
+namespace mp_units::utility {
+
+MP_UNITS_EXPORT_BEGIN
+
+// The counts of the CPU timestamp counter form their own dimensionless kind: their relation to time
+// is only known after calibration, so they must not silently convert to (or from) seconds.
+QUANTITY_SPEC(tsc_cycles, dimensionless, is_kind);
+
+// clang-format off
+inline constexpr struct tsc_cycle final : named_unit<"cyc", one, kind_of<tsc_cycles>> {} tsc_cycle;
+inline constexpr struct tsc_origin final : absolute_point_origin<tsc_cycles> {} tsc_origin;
+// clang-format on
+
+/**
+ * @brief A clock reading the CPU timestamp counter (`rdtsc` on x86, `cntvct_el0` on AArch64)
+ *
+ * `now()` costs a single counter read and returns a `quantity_point` of raw cycles, so the hot path
+ * of an instrumentation stays as cheap as with hand-written `rdtsc` code while timestamps keep
+ * their own unit and origin: a difference of two of them is a `quantity` of cycles, which cannot
+ * be mixed up with seconds.
+ *
+ * The cycles become time only when results are reported, with `to_duration()`, through the period
+ * calibrated against `std::chrono::steady_clock` once, on first use. On other architectures the
+ * counter falls back to `steady_clock` itself with a period of exactly one nanosecond.
+ *
+ * The counter is assumed to be invariant (it ticks at a constant rate regardless of the power
+ * state, as on all recent x86 and AArch64 CPUs) and synchronized between cores.
+ */
+struct tsc_clock {
+  using rep = std::uint64_t;
+  using duration = quantity<tsc_cycle, rep>;
+  using time_point = quantity_point<tsc_cycle, tsc_origin, rep>;
+  using period_type = tick_period<si::nano<si::second>>;
+
+  // `false` when the counter falls back to `steady_clock`
+  static constexpr bool is_hardware_counter = MP_UNITS_HAS_TSC;
+
+  [[nodiscard]] static rep read() noexcept
+  {
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    rep v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return static_cast<rep>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count());
+#endif
+  }
+
+  [[nodiscard]] static time_point now() noexcept { return time_point(duration{read(), tsc_cycle}, tsc_origin); }
+
+  /**
+   * @brief Measures the period of the counter against `steady_clock` over (at least) `window`
+   */
+  [[nodiscard]] static period_type calibrate(std::chrono::steady_clock::duration window = std::chrono::milliseconds{20})
+  {
+    using clock = std::chrono::steady_clock;
+    const clock::time_point start = clock::now();
+    const rep start_cycles = read();
+    clock::time_point stop;
+    do {
+      stop = clock::now();
+    } while (stop - start < window);
+    const rep stop_cycles = read();
+    const quantity elapsed = value_cast<double>(quantity{stop - start});
+    return period_type(elapsed / static_cast<double>(stop_cycles - start_cycles));
+  }
+
+  /**
+   * @brief The period calibrated on the first call (thread-safe)
+   */
+  [[nodiscard]] static const period_type& period()
+  {
+    static const period_type p = is_hardware_counter ? calibrate() : period_type(1. * si::nano<si::second>);
+    return p;
+  }
+
+  /**
+   * @brief Converts a number of cycles to time with the calibrated period
+   */
+  [[nodiscard]] static quantity<si::nano<si::second>, double> to_duration(duration d)
+  {
+    return period()(d.numerical_value_in(tsc_cycle));
+  }
+};
+
+MP_UNITS_EXPORT_END
+
+}  // namespace mp_units::utility
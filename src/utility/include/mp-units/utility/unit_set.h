@@ -0,0 +1,218 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/requires_hosted.h>
+//
+#include <mp-units/bits/module_macros.h>
+
+#ifndef MP_UNITS_IN_MODULE_INTERFACE
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/contracts.h>
+#include <mp-units/framework/customization_points.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/quantity_concepts.h>
+#include <mp-units/framework/unit.h>
+#include <mp-units/utility/bits/exact_scaling.h>
+#include <mp-units/utility/bits/unit_index.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#endif
+#endif
+
+namespace mp_units::utility {
+
+/**
+ * @brief The factor converting a numerical value from one unit to another.
+ *
+ * `value` is always set. When the ratio of the two units is rational and both of its terms fit in
+ * 64 bits, `num / den` holds it exactly (otherwise both are `0`), which lets integral values be
+ * converted without a round trip through `double`.
+ */
+MP_UNITS_EXPORT struct unit_conversion_factor {
+  std::uint64_t num;
+  std::uint64_t den;
+  double value;
+
+  [[nodiscard]] constexpr bool exact() const noexcept { return den != 0; }
+  [[nodiscard]] constexpr bool integral() const noexcept { return den == 1; }
+};
+
+namespace detail {
+
+template<Unit auto From, Unit auto To>
+[[nodiscard]] consteval unit_conversion_factor make_unit_conversion_factor()
+{
+  constexpr auto ratio = get_canonical_unit(From).mag / get_canonical_unit(To).mag;
+  constexpr auto exact = exact_magnitude<ratio>();
+  return {exact[0], exact[1], get_value<double>(ratio)};
+}
+
+template<Unit auto From, Unit auto... Us>
+[[nodiscard]] consteval std::array<unit_conversion_factor, sizeof...(Us)> unit_conversion_row()
+{
+  return {make_unit_conversion_factor<From, Us>()...};
+}
+
+template<Unit auto U, Unit auto... Us>
+[[nodiscard]] consteval bool same_reference_unit()
+{
+  return ((get_canonical_unit(U).reference_unit == get_canonical_unit(Us).reference_unit) && ...);
+}
+
+}  // namespace detail
+
+/**
+ * @brief A fixed set of units of one quantity that values can be converted between at runtime.
+ *
+ * When the unit to convert to is only chosen at runtime (a display setting, a unit read from a
+ * file), `quantity::in()` cannot be used directly. `unit_set` precomputes the `N×N` factors between
+ * its units at compile time from their magnitudes, so a conversion to a runtime-selected unit is a
+ * single indexed load and a multiply.
+ *
+ * Floating-point values are scaled by the `double` factor. Integral values are scaled by the exact
+ * rational factor when there is one (truncating like `value_cast` when it is not integral), and
+ * through `double` otherwise.
+ *
+ * @tparam Us  the units of the set (e.g. `si::metre, si::kilo<si::metre>, yard_pound::foot`); they
+ *             all have to share the same reference unit
+ */
+MP_UNITS_EXPORT template<Unit auto... Us>
+  requires(sizeof...(Us) > 0) && (detail::same_reference_unit<Us...>())
+class unit_set {
+  static constexpr std::array<std::array<unit_conversion_factor, sizeof...(Us)>, sizeof...(Us)> factors_ = {
+    detail::unit_conversion_row<Us, Us...>()...};
+  static constexpr std::array<std::string_view, sizeof...(Us)> symbols_ = {unit_symbol(Us)...};
+
+  template<auto U>
+  static constexpr bool contains = detail::unit_index_of<U, Us...>() < sizeof...(Us);
+
+  template<typename Rep>
+  [[nodiscard]] static constexpr Rep scale(Rep v, const unit_conversion_factor& f) noexcept
+  {
+    if constexpr (treat_as_floating_point<Rep>)
+      return static_cast<Rep>(v * f.value);
+    else if (f.exact())
+      return detail::scale_exact_as<Rep>(v, f.num, f.den);  // only the final narrowing to `Rep` can lose information
+    else
+      return static_cast<Rep>(static_cast<double>(v) * f.value);
+  }
+
+public:
+  static constexpr std::size_t size = sizeof...(Us);
+
+  /**
+   * @brief The position of a unit in the set (its runtime id).
+   */
+  template<Unit U>
+    requires contains<U{}>
+  [[nodiscard]] static consteval std::size_t index_of(U)
+  {
+    return detail::unit_index_of<U{}, Us...>();
+  }
+
+  /**
+   * @brief The position of the unit with the given symbol, if it is in the set.
+   */
+  [[nodiscard]] static constexpr std::optional<std::size_t> find(std::string_view symbol) noexcept
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      if (symbols_[i] == symbol) return i;
+    return std::nullopt;
+  }
+
+  [[nodiscard]] static constexpr std::string_view symbol(std::size_t i) noexcept
+  {
+    MP_UNITS_EXPECTS_DEBUG(i < size);
+    return symbols_[i];
+  }
+
+  [[nodiscard]] static constexpr const unit_conversion_factor& factor(std::size_t from, std::size_t to) noexcept
+  {
+    MP_UNITS_EXPECTS_DEBUG(from < size && to < size);
+    return factors_[from][to];
+  }
+
+  // ==========================================================================
+  // Single values
+  // ==========================================================================
+
+  template<typename Rep>
+    requires std::is_arithmetic_v<Rep>
+  [[nodiscard]] static constexpr Rep convert(Rep value, std::size_t from, std::size_t to) noexcept
+  {
+    return scale(value, factor(from, to));
+  }
+
+  /**
+   * @brief The numerical value of `q` in the unit at position `to`.
+   */
+  template<Quantity Q>
+    requires contains<Q::unit> && std::is_arithmetic_v<typename Q::rep>
+  [[nodiscard]] static constexpr Q::rep convert(const Q& q, std::size_t to) noexcept
+  {
+    return convert(q.numerical_value_in(Q::unit), index_of(Q::unit), to);
+  }
+
+  // ==========================================================================
+  // Batches
+  // ==========================================================================
+
+  /**
+   * @brief Converts a batch of numerical values from the unit at position `from` to `to`.
+   *
+   * The factor is looked up once for the whole batch, so the loop body is a plain multiply the
+   * compiler can vectorize.
+   */
+  template<typename Rep, std::size_t E1, std::size_t E2>
+    requires std::is_arithmetic_v<Rep>
+  static void convert(std::span<const Rep, E1> values, std::size_t from, std::size_t to,
+                      std::span<Rep, E2> out) noexcept
+  {
+    MP_UNITS_EXPECTS(values.size() <= out.size());
+    const unit_conversion_factor f = factor(from, to);
+    for (std::size_t i = 0; i < values.size(); ++i) out[i] = scale(values[i], f);
+  }
+
+  /**
+   * @brief The numerical values of a batch of quantities in the unit at position `to`.
+   */
+  template<Quantity Q, std::size_t E1, std::size_t E2>
+    requires contains<Q::unit> && std::is_arithmetic_v<typename Q::rep>
+  static void convert(std::span<const Q, E1> from, std::size_t to, std::span<typename Q::rep, E2> out) noexcept
+  {
+    MP_UNITS_EXPECTS(from.size() <= out.size());
+    const unit_conversion_factor f = factor(index_of(Q::unit), to);
+    for (std::size_t i = 0; i < from.size(); ++i) out[i] = scale(from[i].numerical_value_in(Q::unit), f);
+  }
+};
+
+}  // namespace mp_units::utility
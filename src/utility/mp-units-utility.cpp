@@ -23,6 +23,31 @@
 module;
 
 #include <mp-units/bits/core_gmf.h>
+#if MP_UNITS_HOSTED && !defined(MP_UNITS_IMPORT_STD)
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <streambuf>
+#include <system_error>
+#include <vector>
+#endif
+#if MP_UNITS_HOSTED && __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 export module mp_units.utility;
 
@@ -35,9 +60,23 @@ import std;
 #define MP_UNITS_IN_MODULE_INTERFACE
 
 #if MP_UNITS_HOSTED
+#include <mp-units/utility/bits/exact_scaling.h>
+#include <mp-units/utility/bits/sharding.h>
+#include <mp-units/utility/bits/unit_index.h>
+//
+#include <mp-units/utility/atomic_quantity.h>
 #include <mp-units/utility/cartesian_tensor.h>
 #include <mp-units/utility/cartesian_vector.h>
+#include <mp-units/utility/column_codec.h>
+#include <mp-units/utility/decimal.h>
+#include <mp-units/utility/dual.h>
+#include <mp-units/utility/exchange_rate_table.h>
+#include <mp-units/utility/mapped_quantity_column.h>
 #include <mp-units/utility/polar_vector.h>
+#include <mp-units/utility/quantity_counter.h>
+#include <mp-units/utility/quantity_histogram.h>
 #include <mp-units/utility/random.h>
 #include <mp-units/utility/spherical_vector.h>
+#include <mp-units/utility/tsc_clock.h>
+#include <mp-units/utility/unit_set.h>
 #endif
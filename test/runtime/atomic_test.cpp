@@ -25,16 +25,37 @@
 import std;
 #else
 #include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
 #endif
 #ifdef MP_UNITS_MODULES
 import mp_units;
 #else
 #include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/iec.h>
 #include <mp-units/systems/si.h>
+#include <mp-units/utility/atomic_quantity.h>
 #endif
 
 using namespace mp_units;
 using namespace mp_units::si::unit_symbols;
+using namespace mp_units::utility;
+
+namespace {
+
+template<typename F>
+void run_concurrently(int threads, F f)
+{
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; ++i) workers.emplace_back(f);
+  for (auto& t : workers) t.join();
+}
+
+template<typename A, typename Q>
+constexpr bool can_fetch_add = requires(A& a, Q q) { a.fetch_add(q); };
+
+}  // namespace
 
 TEST_CASE("std::atomic works with dimensioned types", "[atomic][assignment]")
 {
@@ -42,3 +63,70 @@ TEST_CASE("std::atomic works with dimensioned types", "[atomic][assignment]")
   const std::atomic<quantity<isq::area[m2]>> a2 = 3.0 * isq::area[m2];
   REQUIRE(a1.load() == a2.load());
 }
+
+TEST_CASE("atomic_quantity", "[atomic][atomic_quantity]")
+{
+  SECTION("integral representation")
+  {
+    atomic_quantity<quantity<iec::byte, std::uint64_t>> a;
+    static_assert(decltype(a)::is_always_lock_free);
+    CHECK(a.load() == 0u * iec::byte);
+    CHECK(a.fetch_add(2u * iec::kibi<iec::byte>) == 0u * iec::byte);
+    CHECK(a.fetch_sub(24u * iec::byte) == 2048u * iec::byte);
+    CHECK((a += 1u * iec::byte) == 2025u * iec::byte);
+    CHECK((a -= 25u * iec::byte) == 2000u * iec::byte);
+    CHECK(a.exchange(10u * iec::byte) == 2000u * iec::byte);
+    CHECK(a.load() == 10u * iec::byte);
+  }
+
+  SECTION("only implicitly convertible quantities are accepted")
+  {
+    using bytes = atomic_quantity<quantity<iec::byte, std::uint64_t>>;
+    static_assert(can_fetch_add<bytes, decltype(1u * iec::kibi<iec::byte>)>);
+    static_assert(!can_fetch_add<bytes, decltype(1u * iec::bit)>);
+    static_assert(!can_fetch_add<bytes, decltype(1. * iec::byte)>);
+    static_assert(!can_fetch_add<bytes, decltype(1 * si::second)>);
+  }
+
+  SECTION("compare_exchange")
+  {
+    atomic_quantity<quantity<si::joule>> e = 1. * J;
+    quantity expected = 2. * J;
+    CHECK_FALSE(e.compare_exchange_strong(expected, 3. * J));
+    CHECK(expected == 1. * J);
+    CHECK(e.compare_exchange_strong(expected, 3. * J));
+    CHECK(e.load() == 3. * J);
+  }
+
+  SECTION("concurrent floating-point accumulation")
+  {
+    atomic_quantity<quantity<si::joule>> energy;
+    run_concurrently(8, [&] {
+      for (int i = 0; i < 1000; ++i) energy.fetch_add(1. * si::kilo<si::joule>);
+    });
+    CHECK(energy.load() == 8'000'000. * J);
+  }
+}
+
+TEST_CASE("sharded_atomic_quantity", "[atomic][sharded_atomic_quantity]")
+{
+  SECTION("sequential")
+  {
+    sharded_atomic_quantity<quantity<iec::byte, std::uint64_t>, 4> c;
+    c += 1u * iec::kibi<iec::byte>;
+    c -= 24u * iec::byte;
+    c.add(1u * iec::byte);
+    CHECK(c.load() == 1001u * iec::byte);
+    CHECK(c.exchange_zero() == 1001u * iec::byte);
+    CHECK(c.load() == 0u * iec::byte);
+  }
+
+  SECTION("concurrent")
+  {
+    sharded_atomic_quantity<quantity<iec::byte, std::uint64_t>, 4> c;
+    run_concurrently(16, [&] {
+      for (int i = 0; i < 10'000; ++i) c += 1u * iec::byte;
+    });
+    CHECK(c.load() == 160'000u * iec::byte);
+  }
+}
@@ -0,0 +1,99 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <mp-units/systems/si.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ratio>
+#include <vector>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+using usec = quantity<si::micro<si::second>, double>;
+
+// a clock ticking at 3 GHz, like a CPU timestamp counter, but with the period known at compile time
+using cpu_ticks = std::chrono::duration<std::int64_t, std::ratio<1, 3'000'000'000>>;
+
+}  // namespace
+
+TEST_CASE("chrono durations with an arbitrary period", "[chrono]")
+{
+  SECTION("compile-time period")
+  {
+    const usec q = cpu_ticks{4'500};
+    CHECK_THAT(q.numerical_value_in(us), WithinRel(1.5, 1e-15));
+  }
+
+  SECTION("runtime-calibrated period")
+  {
+    // e.g. the frequency of the timestamp counter measured against `steady_clock` at startup
+    const tick_period<us> tsc(3. * si::giga<si::hertz>);
+    const std::uint64_t start = 1'000'000;
+    const std::uint64_t stop = start + 4'500;
+    CHECK_THAT(tsc(stop - start).numerical_value_in(us), WithinRel(1.5, 1e-15));
+    CHECK_THAT(tsc.period().numerical_value_in(ps), WithinRel(1000. / 3, 1e-15));
+  }
+}
+
+TEST_CASE("chrono bridge benchmark", "[.][benchmark][chrono]")
+{
+  constexpr std::size_t size = 1'000'000;
+  std::vector<std::chrono::steady_clock::duration> durations(size);
+  std::vector<std::uint64_t> ticks(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    durations[i] = std::chrono::nanoseconds(static_cast<std::int64_t>(i * 7919 % 100'000));
+    ticks[i] = static_cast<std::uint64_t>(durations[i].count()) * 3;
+  }
+  std::vector<usec> out(size);
+  const tick_period<us> tsc(3. * si::giga<si::hertz>);
+
+  BENCHMARK("duration_cast<duration<double, micro>> then construction")
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      out[i] = usec(std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(durations[i]));
+    return out[size - 1];
+  };
+
+  BENCHMARK("implicit conversion of the duration")
+  {
+    for (std::size_t i = 0; i < size; ++i) out[i] = durations[i];
+    return out[size - 1];
+  };
+
+  BENCHMARK("tick_period of runtime-calibrated ticks")
+  {
+    for (std::size_t i = 0; i < size; ++i) out[i] = tsc(ticks[i]);
+    return out[size - 1];
+  };
+}
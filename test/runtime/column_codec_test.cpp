@@ -0,0 +1,192 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#include <mp-units/utility/column_codec.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::utility;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+using Catch::Matchers::WithinULP;
+
+template<typename T>
+std::vector<T> iota_column(std::size_t n, auto unit)
+{
+  std::vector<T> res;
+  res.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) res.emplace_back(static_cast<typename T::rep>(i) * unit);
+  return res;
+}
+
+}  // namespace
+
+TEST_CASE("column files round trip", "[column_codec]")
+{
+  const auto lengths = iota_column<quantity<isq::height[m], double>>(1000, isq::height[m]);
+  const auto counts = iota_column<quantity<one, std::int32_t>>(10, one);
+  const std::vector points = {point<m>(-1.5), point<m>(8848.86)};
+
+  std::stringstream ss;
+  write_columns(ss, std::span{lengths}, std::span{counts}, std::span{points});
+
+  column_reader reader(ss);
+  REQUIRE(reader.columns().size() == 3);
+
+  const column_header& h = reader.columns()[0];
+  CHECK(h.kind == rep_kind::floating_point);
+  CHECK(h.rep_size == sizeof(double));
+  CHECK(h.unit_symbol == "m");
+  CHECK(h.dimension_symbol == "L");
+  CHECK(h.point_origin.empty());
+  CHECK(h.size == 1000);
+  for (const column_header& c : reader.columns()) CHECK(c.offset % 64 == 0);
+  CHECK(reader.columns()[1].kind == rep_kind::signed_integer);
+  CHECK(reader.columns()[2].point_origin == "natural");
+
+  CHECK(reader.read<quantity<isq::height[m], double>>(0) == lengths);
+  CHECK(reader.read<quantity<one, std::int32_t>>(1) == counts);
+  CHECK(reader.read<quantity_point<m, default_point_origin(si::metre), double>>(2) == points);
+}
+
+TEST_CASE("column files are converted to the requested unit when loaded", "[column_codec]")
+{
+  const std::vector lengths = {1. * km, 2.5 * km, 42. * km};
+  const std::vector durations = {std::int64_t{1500} * ms, std::int64_t{-20} * ms};
+
+  std::stringstream ss;
+  write_columns(ss, std::span{lengths}, std::span{durations});
+  column_reader reader(ss);
+
+  const auto metres = reader.read<quantity<m, double>>(0);
+  REQUIRE(metres.size() == 3);
+  CHECK(metres[0] == 1000. * m);
+  CHECK(metres[1] == 2500. * m);
+  CHECK(metres[2] == 42000. * m);
+
+  std::vector<quantity<s, float>> seconds(2);
+  reader.read(1, std::span{seconds});
+  CHECK_THAT(seconds[0].numerical_value_in(s), WithinULP(1.5f, 1));
+  CHECK_THAT(seconds[1].numerical_value_in(s), WithinULP(-0.02f, 1));
+}
+
+TEST_CASE("integral columns are scaled exactly", "[column_codec]")
+{
+  // above 2^53, so not exactly representable as a `double` before scaling
+  constexpr std::int64_t big = (std::int64_t{1} << 53) + 3;
+  const std::vector durations = {std::int64_t{1500} * ms, std::int64_t{-20} * ms};
+  const std::vector distances = {big * km};
+  const std::vector<quantity<m, std::int32_t>> lengths = {std::int32_t{7} * m};
+
+  std::stringstream ss;
+  write_columns(ss, std::span{durations}, std::span{distances}, std::span{lengths});
+  column_reader reader(ss);
+
+  SECTION("integral factor")
+  {
+    CHECK(reader.read<quantity<us, std::int64_t>>(0) ==
+          std::vector{std::int64_t{1'500'000} * us, std::int64_t{-20'000} * us});
+    CHECK(reader.read<quantity<m, std::int64_t>>(1) == std::vector{big * 1000 * m});
+  }
+
+  SECTION("same unit, wider representation")
+  {
+    CHECK(reader.read<quantity<m, std::int64_t>>(2) == std::vector{std::int64_t{7} * m});
+  }
+
+  SECTION("floating-point targets are rounded once")
+  {
+    const auto metres = reader.read<quantity<m, double>>(1);
+    CHECK(metres[0].numerical_value_in(m) == static_cast<double>(static_cast<std::uint64_t>(big) * 1000u));
+  }
+}
+
+TEST_CASE("column files are validated against the requested type", "[column_codec]")
+{
+  const std::vector lengths = {1. * km};
+  const std::vector ticks = {std::int64_t{1} * ms};
+  const std::vector distances = {std::numeric_limits<std::int64_t>::max() / 10 * km};
+
+  std::stringstream ss;
+  write_columns(ss, std::span{lengths}, std::span{ticks}, std::span{distances});
+  column_reader reader(ss);
+
+  CHECK_THROWS_AS((reader.read<quantity<s, double>>(0)), std::invalid_argument);
+  CHECK_THROWS_AS((reader.read<quantity_point<m, default_point_origin(si::metre), double>>(0)), std::invalid_argument);
+  CHECK_THROWS_AS((reader.read<quantity<s, std::int64_t>>(1)), std::invalid_argument);  // would truncate
+  CHECK_THROWS_AS((reader.read<quantity<km, std::int64_t>>(0)), std::invalid_argument);  // floating-point column
+  CHECK_THROWS_AS((reader.read<quantity<ms, std::int32_t>>(1)), std::invalid_argument);   // narrower
+  CHECK_THROWS_AS((reader.read<quantity<ms, std::uint64_t>>(1)), std::invalid_argument);  // different signedness
+  CHECK_THROWS_AS((reader.read<quantity<m, std::int64_t>>(2)), std::overflow_error);
+
+  std::vector<quantity<km, double>> too_small(0);
+  CHECK_THROWS_AS(reader.read(0, std::span{too_small}), std::invalid_argument);
+
+  std::stringstream garbage("not a column file");
+  CHECK_THROWS_AS(column_reader(garbage), std::runtime_error);
+}
+
+TEST_CASE("column file throughput", "[.][benchmark][column_codec]")
+{
+  const auto lengths = iota_column<quantity<km, double>>(1 << 20, km);
+  std::stringstream ss;
+  write_columns(ss, std::span{lengths});
+  const std::string file = ss.str();
+
+  BENCHMARK("write")
+  {
+    std::stringstream out;
+    write_columns(out, std::span{lengths});
+    return out.tellp();
+  };
+  BENCHMARK("read as stored")
+  {
+    std::stringstream in(file);
+    return column_reader(in).read<quantity<km, double>>(0);
+  };
+  BENCHMARK("read converted")
+  {
+    std::stringstream in(file);
+    return column_reader(in).read<quantity<m, double>>(0);
+  };
+}
@@ -0,0 +1,82 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/compat_macros.h>
+#include <mp-units/ext/format.h>
+#include <mp-units/systems/si.h>
+#include <mp-units/utility/decimal.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::utility;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+using dec2 = decimal<std::int64_t, 2>;
+using dec0 = decimal<std::int64_t, 0>;
+
+template<typename T>
+std::string to_string(const T& v)
+{
+  std::ostringstream os;
+  os << v;
+  return os.str();
+}
+
+}  // namespace
+
+TEST_CASE("decimal text output", "[decimal][text]")
+{
+  SECTION("ostream")
+  {
+    CHECK(to_string(dec2::from_raw(1295)) == "12.95");
+    CHECK(to_string(dec2::from_raw(5)) == "0.05");
+    CHECK(to_string(dec2::from_raw(-5)) == "-0.05");
+    CHECK(to_string(dec2::from_raw(-1200)) == "-12.00");
+    CHECK(to_string(dec2{}) == "0.00");
+    CHECK(to_string(dec0{42}) == "42");
+    CHECK(to_string(std::numeric_limits<dec2>::min()) == "-92233720368547758.08");
+  }
+
+  SECTION("format")
+  {
+    CHECK(MP_UNITS_STD_FMT::format("{}", dec2::from_raw(1295)) == "12.95");
+    CHECK(MP_UNITS_STD_FMT::format("[{:>8}]", dec2::from_raw(-5)) == "[   -0.05]");
+  }
+
+  SECTION("quantity")
+  {
+    const quantity q = dec2::from_raw(12345) * m;
+    CHECK(to_string(q) == "123.45 m");
+    CHECK(MP_UNITS_STD_FMT::format("{}", q.in(cm)) == "12345.00 cm");
+    CHECK(MP_UNITS_STD_FMT::format("{}", q.force_in(km)) == "0.12 km");
+  }
+}
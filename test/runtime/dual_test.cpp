@@ -0,0 +1,229 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <sstream>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/math.h>
+#include <mp-units/systems/angular.h>
+#include <mp-units/systems/angular/math.h>
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#include <mp-units/systems/si/math.h>
+#include <mp-units/utility/dual.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::utility;
+using namespace mp_units::si::unit_symbols;
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+using d1 = dual<double, 1>;
+using d2 = dual<double, 2>;
+using d8 = dual<double, 8>;
+
+// checks the value and the derivative of a unary function of one independent variable
+template<typename F>
+void check_derivative(F f, double at, double expected_value, double expected_derivative)
+{
+  const d1 res = f(d1::variable(at, 0));
+  CHECK_THAT(res.value(), WithinRel(expected_value, 1e-12));
+  CHECK_THAT(res.tangent(0), WithinRel(expected_derivative, 1e-12));
+}
+
+}  // namespace
+
+TEST_CASE("dual math functions", "[dual][math]")
+{
+  SECTION("powers and exponentials")
+  {
+    check_derivative([](const d1& x) { return sqrt(x); }, 4.0, 2.0, 0.25);
+    check_derivative([](const d1& x) { return cbrt(x); }, 8.0, 2.0, 1.0 / 12);
+    check_derivative([](const d1& x) { return exp(x); }, 1.0, std::numbers::e, std::numbers::e);
+    check_derivative([](const d1& x) { return log(x); }, 2.0, std::log(2.0), 0.5);
+    check_derivative([](const d1& x) { return pow(x, 3.0); }, 2.0, 8.0, 12.0);
+    check_derivative([](const d1& x) { return pow(x, x); }, 2.0, 4.0, 4.0 * (1.0 + std::log(2.0)));
+  }
+
+  SECTION("trigonometry")
+  {
+    check_derivative([](const d1& x) { return sin(x); }, 1.0, std::sin(1.0), std::cos(1.0));
+    check_derivative([](const d1& x) { return cos(x); }, 1.0, std::cos(1.0), -std::sin(1.0));
+    check_derivative([](const d1& x) { return tan(x); }, 1.0, std::tan(1.0), 1.0 / (std::cos(1.0) * std::cos(1.0)));
+    check_derivative([](const d1& x) { return asin(x); }, 0.5, std::asin(0.5), 1.0 / std::sqrt(0.75));
+    check_derivative([](const d1& x) { return acos(x); }, 0.5, std::acos(0.5), -1.0 / std::sqrt(0.75));
+    check_derivative([](const d1& x) { return atan(x); }, 2.0, std::atan(2.0), 0.2);
+  }
+
+  SECTION("functions of two variables")
+  {
+    const d2 x = d2::variable(3.0, 0);
+    const d2 y = d2::variable(4.0, 1);
+
+    const d2 h = hypot(x, y);
+    CHECK(h.value() == 5.0);
+    CHECK_THAT(h.tangent(0), WithinRel(0.6, 1e-15));
+    CHECK_THAT(h.tangent(1), WithinRel(0.8, 1e-15));
+
+    const d2 a = atan2(y, x);
+    CHECK_THAT(a.value(), WithinRel(std::atan2(4.0, 3.0), 1e-15));
+    CHECK_THAT(a.tangent(0), WithinRel(-4.0 / 25, 1e-15));
+    CHECK_THAT(a.tangent(1), WithinRel(3.0 / 25, 1e-15));
+
+    const d2 f = fma(x, y, x);
+    CHECK(f.value() == 15.0);
+    CHECK(f.tangents() == std::array{5.0, 3.0});
+  }
+
+  SECTION("classification and rounding only look at the value")
+  {
+    const d1 x = d1::variable(2.5, 0);
+    CHECK(isfinite(x));
+    CHECK_FALSE(isnan(x));
+    CHECK_FALSE(isinf(x));
+    CHECK(floor(x) == 2.0);
+    CHECK(ceil(x).tangent(0) == 0.0);
+  }
+
+  SECTION("text output")
+  {
+    std::ostringstream os;
+    os << d2::variable(1.5, 1);
+    CHECK(os.str() == "1.5 [0, 1]");
+  }
+}
+
+TEST_CASE("dual quantities", "[dual][quantity]")
+{
+  SECTION("math.h overloads")
+  {
+    const quantity side = d1::variable(9.0, 0) * m2;
+    const quantity<m, d1> root = sqrt(side);
+    CHECK(root.numerical_value_in(m).value() == 3.0);
+    CHECK_THAT(root.numerical_value_in(m).tangent(0), WithinRel(1.0 / 6, 1e-15));
+
+    const quantity<m, d2> diagonal = hypot(d2::variable(3.0, 0) * m, d2::variable(400.0, 1) * cm);
+    CHECK(diagonal.numerical_value_in(m).value() == 5.0);
+    CHECK_THAT(diagonal.numerical_value_in(m).tangent(0), WithinRel(0.6, 1e-15));  // m/m
+    CHECK_THAT(diagonal.numerical_value_in(m).tangent(1), WithinRel(0.008, 1e-15));  // m/cm
+
+    const quantity<one, d1> e = exp(d1::variable(0.0, 0) * one);
+    CHECK(e.numerical_value_in(one).tangents() == std::array{1.0});
+  }
+
+  SECTION("trigonometric functions of angles")
+  {
+    const d1 theta = d1::variable(30.0, 0);
+    const quantity s1 = si::sin(theta * deg);
+    const quantity s2 = angular::sin(theta * angular::degree);
+    const double expected = std::cos(std::numbers::pi / 6) * std::numbers::pi / 180;  // per degree
+    CHECK_THAT(s1.numerical_value_in(one).value(), WithinRel(0.5, 1e-15));
+    CHECK_THAT(s1.numerical_value_in(one).tangent(0), WithinRel(expected, 1e-15));
+    CHECK_THAT(s2.numerical_value_in(one).tangent(0), WithinRel(expected, 1e-15));
+  }
+
+  SECTION("gradient of a unit-checked model")
+  {
+    // E = m v² / 2 + m g h
+    std::array<d8, 3> inputs = {d8::variable(2.0, 0), d8::variable(3.0, 1), d8::variable(10.0, 2)};
+    const quantity mass = inputs[0] * kg;
+    const quantity speed = inputs[1] * (m / s);
+    const quantity height = inputs[2] * m;
+    const quantity<isq::energy[J], d8> energy = mass * pow<2>(speed) / 2 + mass * (9.81 * (m / s2)) * height;
+
+    const d8& e = energy.numerical_value_in(J);
+    CHECK_THAT(e.value(), WithinRel(9.0 + 196.2, 1e-15));
+    CHECK_THAT(e.tangent(0), WithinRel(4.5 + 98.1, 1e-15));  // J/kg
+    CHECK_THAT(e.tangent(1), WithinRel(6.0, 1e-15));         // J/(m/s)
+    CHECK_THAT(e.tangent(2), WithinRel(19.62, 1e-15));       // J/m
+    for (std::size_t i = 3; i < d8::size; ++i) CHECK_THAT(e.tangent(i), WithinAbs(0.0, 0.0));
+  }
+}
+
+TEST_CASE("dual gradient benchmark", "[.][benchmark][dual]")
+{
+  constexpr std::size_t count = 1024;
+  std::vector<double> values(count);
+  for (std::size_t i = 0; i < count; ++i) values[i] = 1.0 + static_cast<double>(i) / count;
+
+  // a function of 8 variables: Σ xᵢ² × exp(x₀ × x₇)
+  const auto model = [](const auto& x) {
+    auto sum = x[0] * x[0];
+    for (std::size_t i = 1; i < 8; ++i) sum += x[i] * x[i];
+    return sum * exp(x[0] * x[7]);
+  };
+
+  BENCHMARK("value only (double)")
+  {
+    double res = 0;
+    for (double v : values) {
+      std::array<double, 8> x;
+      for (std::size_t i = 0; i < 8; ++i) x[i] = v + static_cast<double>(i);
+      res += model(x);
+    }
+    return res;
+  };
+
+  BENCHMARK("gradient with finite differences (9 evaluations)")
+  {
+    double res = 0;
+    for (double v : values) {
+      std::array<double, 8> x;
+      for (std::size_t i = 0; i < 8; ++i) x[i] = v + static_cast<double>(i);
+      const double f = model(x);
+      for (std::size_t i = 0; i < 8; ++i) {
+        std::array<double, 8> xh = x;
+        xh[i] += 1e-6;
+        res += (model(xh) - f) / 1e-6;
+      }
+    }
+    return res;
+  };
+
+  BENCHMARK("gradient with dual<double, 8>")
+  {
+    double res = 0;
+    for (double v : values) {
+      std::array<d8, 8> x;
+      for (std::size_t i = 0; i < 8; ++i) x[i] = d8::variable(v + static_cast<double>(i), i);
+      const d8 f = model(x);
+      for (double t : f.tangents()) res += t;
+    }
+    return res;
+  };
+}
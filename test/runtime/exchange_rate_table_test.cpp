@@ -0,0 +1,128 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <catch2/catch_test_macros.hpp>
+#include <mp-units/framework.h>
+#include <mp-units/utility/exchange_rate_table.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::utility;
+
+namespace {
+
+// clang-format off
+inline constexpr struct dim_currency final : base_dimension<"$"> {} dim_currency;
+QUANTITY_SPEC(currency, dim_currency);
+inline constexpr struct euro final : named_unit<"EUR", kind_of<currency>> {} euro;
+inline constexpr struct us_dollar final : named_unit<"USD", kind_of<currency>> {} us_dollar;
+inline constexpr struct japanese_jen final : named_unit<"JPY", kind_of<currency>> {} japanese_jen;
+// clang-format on
+
+using rate_table = exchange_rate_table<currency, euro, us_dollar, japanese_jen>;
+
+}  // namespace
+
+static_assert(rate_table::size == 3);
+static_assert(rate_table::index_of(euro) == 0);
+static_assert(rate_table::index_of(us_dollar) == 1);
+static_assert(rate_table::index_of(japanese_jen) == 2);
+
+TEST_CASE("exchange_rate_table lookups", "[exchange_rate_table]")
+{
+  rate_table table;
+
+  SECTION("diagonal is identity and missing quotes are NaN")
+  {
+    CHECK(table.rate(euro, euro) == 1.0);
+    CHECK(table.rate(2, 2) == 1.0);
+    CHECK(std::isnan(table.rate(euro, us_dollar)));
+    CHECK(std::isnan(table.convert<us_dollar>(1. * euro).numerical_value_in(us_dollar)));
+  }
+
+  SECTION("typed and runtime-indexed access address the same entry")
+  {
+    table.set_rate(euro, us_dollar, 1.08);
+    CHECK(table.rate(0, 1) == 1.08);
+    table.set_rate(rate_table::index_of(us_dollar), rate_table::index_of(japanese_jen), 150.);
+    CHECK(table.rate(us_dollar, japanese_jen) == 150.);
+    CHECK(std::isnan(table.rate(japanese_jen, us_dollar)));
+  }
+
+  SECTION("convert")
+  {
+    table.set_rate(euro, us_dollar, 1.25);
+    const quantity q = table.convert<us_dollar>(100. * euro);
+    static_assert(std::is_same_v<decltype(q), const quantity<us_dollar, double>>);
+    CHECK(q == 125. * us_dollar);
+
+    const quantity qi = table.convert<us_dollar, int>(100 * euro);
+    static_assert(std::is_same_v<decltype(qi), const quantity<us_dollar, int>>);
+    CHECK(qi == 125 * us_dollar);
+  }
+
+  SECTION("batch convert")
+  {
+    table.set_rate(us_dollar, euro, 0.5);
+    const std::array from = {2. * us_dollar, 4. * us_dollar, 6. * us_dollar};
+    std::array<quantity<currency[euro]>, 3> to{};
+    table.convert(std::span{from}, std::span{to});
+    CHECK(to[0] == 1. * euro);
+    CHECK(to[1] == 2. * euro);
+    CHECK(to[2] == 3. * euro);
+  }
+}
+
+TEST_CASE("exchange_rate_table concurrent updates", "[exchange_rate_table][atomic]")
+{
+  rate_table table;
+  table.set_rate(euro, us_dollar, 1.0);
+
+  constexpr int updates = 10'000;
+  std::atomic<bool> done = false;
+  std::vector<std::thread> readers;
+  std::atomic<int> torn = 0;
+  for (int i = 0; i < 4; ++i)
+    readers.emplace_back([&] {
+      while (!done.load(std::memory_order_acquire)) {
+        // every published rate is an integral value, so a torn read would show up as a fraction
+        const double r = table.convert<us_dollar>(1. * euro).numerical_value_in(us_dollar);
+        if (r != std::floor(r) || r < 1.0 || r > updates) ++torn;
+      }
+    });
+
+  for (int i = 1; i <= updates; ++i) table.set_rate(euro, us_dollar, static_cast<double>(i));
+  done.store(true, std::memory_order_release);
+  for (auto& t : readers) t.join();
+
+  CHECK(torn == 0);
+  CHECK(table.rate(euro, us_dollar) == updates);
+}
@@ -20,6 +20,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_exception.hpp>
@@ -30,6 +31,7 @@ import std;
 #else
 #include <cstdint>
 #include <iomanip>
+#include <iterator>
 #include <limits>
 #include <locale>
 #include <sstream>
@@ -316,6 +318,45 @@ TEST_CASE("unit formatting error handling", "[unit][fmt][exception]")
   }
 }
 
+TEST_CASE("unit formatting covers every modifier combination", "[unit][fmt]")
+{
+  const auto u = kg * m / (s2 * K);
+  for (const char* const char_set : {"U", "P"})
+    for (const char* const solidus : {"1", "a", "n"})
+      for (const char* const separator : {"s", "d"}) {
+        if (*char_set == 'P' && *separator == 'd') continue;  // not allowed
+        unit_symbol_formatting fmt{};
+        fmt.char_set = *char_set == 'U' ? character_set::utf8 : character_set::portable;
+        fmt.solidus = *solidus == '1'   ? unit_symbol_solidus::one_denominator
+                      : *solidus == 'a' ? unit_symbol_solidus::always
+                                        : unit_symbol_solidus::never;
+        fmt.separator = *separator == 's' ? unit_symbol_separator::space : unit_symbol_separator::half_high_dot;
+        std::string expected;
+        unit_symbol_to<char>(std::back_inserter(expected), u, fmt);
+
+        const std::string spec = std::string("{:") + char_set + solidus + separator + "}";
+        CHECK(MP_UNITS_STD_FMT::vformat(spec, MP_UNITS_STD_FMT::make_format_args(u)) == expected);
+      }
+}
+
+TEST_CASE("unit formatting benchmark", "[.][benchmark][unit][fmt]")
+{
+  const auto u = kg * m / (s2 * K);
+  for (const char* const spec :
+       {"{:U1s}", "{:U1d}", "{:Uas}", "{:Uad}", "{:Uns}", "{:Und}", "{:P1s}", "{:Pas}", "{:Pns}"}) {
+    BENCHMARK(std::string("format ") + spec)
+    {
+      return MP_UNITS_STD_FMT::vformat(spec, MP_UNITS_STD_FMT::make_format_args(u));
+    };
+  }
+  BENCHMARK("rebuild with unit_symbol_to (previous formatter implementation)")
+  {
+    char buf[128];
+    const char* const end = unit_symbol_to<char>(buf, u, unit_symbol_formatting{});
+    return std::string_view{buf, end}.size();
+  };
+}
+
 TEST_CASE("default quantity formatting", "[quantity][ostream][fmt]")
 {
   std::ostringstream os;
@@ -0,0 +1,197 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Exercises the batch transforms of the GLM integration on spans of vertex-like quantities. The
+// build system compiles this file only when GLM is available.
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <vector>
+#endif
+
+#include <mp-units/integrations/glm.h>
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+using Catch::Matchers::WithinAbs;
+
+// a position is a point measured from the origin of the scene, not a displacement
+template<Unit auto U>
+using position = quantity_point<isq::displacement[U], default_point_origin(isq::displacement[U]), glm::dvec3>;
+
+template<Unit auto U>
+using displacement = quantity<isq::displacement[U], glm::dvec3>;
+
+void check_near(const glm::dvec3& actual, const glm::dvec3& expected)
+{
+  CHECK_THAT(actual.x, WithinAbs(expected.x, 1e-12));
+  CHECK_THAT(actual.y, WithinAbs(expected.y, 1e-12));
+  CHECK_THAT(actual.z, WithinAbs(expected.z, 1e-12));
+}
+
+template<QuantityPoint QP>
+[[nodiscard]] const glm::dvec3& value(const QP& qp)
+{
+  return qp.quantity_ref_from(QP::point_origin).numerical_value_ref_in(QP::unit);
+}
+
+// a quarter turn about the z axis followed by a shift by (1, 2, 3) m
+[[nodiscard]] glm::dmat4 make_pose()
+{
+  return glm::rotate(glm::translate(glm::dmat4(1.), glm::dvec3(1., 2., 3.)), std::numbers::pi / 2,
+                     glm::dvec3(0., 0., 1.));
+}
+
+template<typename From, typename To, Unit auto U = si::metre>
+constexpr bool transformable = requires(std::span<const From> from, std::span<To> to) {
+  transform(glm::dmat4(1.), U, from, to);
+};
+
+template<typename From, typename To>
+constexpr bool translatable = requires(std::span<const From> from, std::span<To> to) {
+  translate(displacement<m>{}, from, to);
+};
+
+// positions are moved by a pose, while displacements (e.g. normals or velocities) are only rotated
+static_assert(transformable<position<m>, position<mm>>);
+static_assert(transformable<displacement<m>, displacement<mm>>);
+static_assert(translatable<position<m>, position<mm>>);
+static_assert(!translatable<displacement<m>, displacement<m>>);
+
+// a position cannot become a displacement, and a length is not a time
+static_assert(!transformable<position<m>, displacement<m>>);
+static_assert(!transformable<displacement<m>, position<m>>);
+static_assert(!transformable<position<m>, position<m>, si::second>);
+
+}  // namespace
+
+TEST_CASE("GLM batch transforms", "[glm][transform]")
+{
+  const std::array points = {position<m>(displacement<m>(glm::dvec3(1., 0., 0.), m)),
+                             position<m>(displacement<m>(glm::dvec3(0., 2., 0.), m))};
+
+  SECTION("rotate")
+  {
+    const glm::dmat3 quarter_turn = glm::dmat3(make_pose());
+    std::array<position<m>, 2> out{};
+    rotate(quarter_turn, std::span{points}, std::span{out});
+    check_near(value(out[0]), {0., 1., 0.});
+    check_near(value(out[1]), {-2., 0., 0.});
+  }
+
+  SECTION("translate")
+  {
+    std::array<position<mm>, 2> out{};
+    translate(displacement<cm>(glm::dvec3(10., 0., -5.), cm), std::span{points}, std::span{out});
+    check_near(value(out[0]), {1100., 0., -50.});
+    check_near(value(out[1]), {100., 2000., -50.});
+  }
+
+  SECTION("transform positions")
+  {
+    std::array<position<m>, 2> out{};
+    transform(make_pose(), m, std::span{points}, std::span{out});
+    check_near(value(out[0]), {1., 3., 3.});
+    check_near(value(out[1]), {-1., 2., 3.});
+  }
+
+  SECTION("transform positions with unit conversions")
+  {
+    // the pose translates by (1000, 2000, 3000) mm, the input is in km, and the output in m
+    glm::dmat4 pose = make_pose();
+    pose[3] = glm::dvec4(1000., 2000., 3000., 1.);
+    const std::array in = {position<km>(displacement<km>(glm::dvec3(0.001, 0., 0.), km))};
+    std::array<position<m>, 1> out{};
+    transform(pose, mm, std::span{in}, std::span{out});
+    check_near(value(out[0]), {1., 3., 3.});
+  }
+
+  SECTION("transform displacements ignores the translation")
+  {
+    const std::array normals = {displacement<m>(glm::dvec3(1., 0., 0.), m)};
+    std::array<displacement<mm>, 1> out{};
+    transform(make_pose(), m, std::span{normals}, std::span{out});
+    check_near(out[0].numerical_value_ref_in(mm), {0., 1000., 0.});
+  }
+
+  SECTION("project")
+  {
+    const glm::dmat4 proj = glm::perspective(std::numbers::pi / 2, 1., 1., 100.);
+    const std::array in = {position<cm>(displacement<cm>(glm::dvec3(100., 50., -200.), cm))};
+    std::array<glm::dvec3, 1> ndc{};
+    project(proj, m, std::span{in}, std::span{ndc});
+    const glm::dvec4 clip = proj * glm::dvec4(1., 0.5, -2., 1.);
+    check_near(ndc[0], glm::dvec3(clip) / clip.w);
+  }
+}
+
+TEST_CASE("GLM batch transform benchmark", "[.][benchmark][glm][transform]")
+{
+  constexpr std::size_t size = 1'000'000;
+  std::vector<glm::dvec3> raw_in(size);
+  std::vector<position<m>> in(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto x = static_cast<double>(i);
+    raw_in[i] = glm::dvec3(x, 2. * x, 3. * x);
+    in[i] = position<m>(displacement<m>(raw_in[i], m));
+  }
+  std::vector<glm::dvec3> raw_out(size);
+  std::vector<position<m>> out(size);
+  std::vector<position<mm>> out_mm(size);
+  const glm::dmat4 pose = make_pose();
+
+  BENCHMARK("raw GLM: out = pose * vec4(in, 1)")
+  {
+    for (std::size_t i = 0; i < size; ++i) raw_out[i] = glm::dvec3(pose * glm::dvec4(raw_in[i], 1.));
+    return raw_out[size - 1].x;
+  };
+
+  BENCHMARK("transform(pose, m, in, out)")
+  {
+    transform(pose, m, std::span<const position<m>>(in), std::span{out});
+    return value(out[size - 1]).x;
+  };
+
+  BENCHMARK("transform(pose, m, in, out) with a conversion to mm")
+  {
+    transform(pose, m, std::span<const position<m>>(in), std::span{out_mm});
+    return value(out_mm[size - 1]).x;
+  };
+}
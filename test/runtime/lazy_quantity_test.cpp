@@ -0,0 +1,195 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Exercises `lazy_quantity` on top of the dynamic-size vectors of a third-party expression-template
+// library. Like `linear_algebra_test`, the backend is selected from whichever library is available
+// on the include path, and the build system compiles this file once per library it finds.
+
+#if __has_include(<Eigen/Core>)
+#include <Eigen/Core>
+#define MP_UNITS_LA_EIGEN
+#elif __has_include(<blaze/math/DynamicVector.h>)
+#include <blaze/math/DynamicVector.h>
+#define MP_UNITS_LA_BLAZE
+#endif
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#endif
+
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+#if defined(MP_UNITS_LA_EIGEN)
+#include <mp-units/integrations/eigen.h>
+#elif defined(MP_UNITS_LA_BLAZE)
+#include <mp-units/integrations/blaze.h>
+#endif
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+using Catch::Matchers::WithinRel;
+
+#if defined(MP_UNITS_LA_EIGEN)
+using vec = Eigen::VectorXd;
+using ivec = Eigen::VectorXi;
+#elif defined(MP_UNITS_LA_BLAZE)
+using vec = blaze::DynamicVector<double>;
+using ivec = blaze::DynamicVector<int>;
+#endif
+
+[[nodiscard]] vec make_vec(std::size_t size, double first, double step)
+{
+  vec res(size);
+  for (std::size_t i = 0; i < size; ++i)
+    res[static_cast<decltype(res.size())>(i)] = first + step * static_cast<double>(i);
+  return res;
+}
+
+[[nodiscard]] double at(const vec& v, std::size_t i) { return v[static_cast<decltype(v.size())>(i)]; }
+
+using position = quantity<isq::displacement[m], vec>;
+using velocity = quantity<isq::velocity[m / s], vec>;
+
+template<typename A, typename B>
+concept lazy_addable = requires(const A& a, const B& b) { lazy(a) + lazy(b); };
+
+// --- compile-time guarantees -------------------------------------------------------------------
+
+// A lazy quantity keeps the expression (not the evaluated vector) and the reference on the side.
+static_assert(!std::same_as<decltype(lazy(std::declval<const position&>()) +
+                                     lazy(std::declval<const position&>()))::expression_type,
+                            vec>);
+static_assert(std::same_as<decltype(lazy(std::declval<const position&>()) +
+                                    lazy(std::declval<const position&>()))::rep,
+                           vec>);
+static_assert(decltype(lazy(std::declval<const position&>()) +
+                       (2. * s) * lazy(std::declval<const velocity&>()))::reference == isq::displacement[m]);
+
+// The units are checked like for eager quantities.
+static_assert(lazy_addable<position, quantity<isq::displacement[km], vec>>);
+static_assert(!lazy_addable<position, velocity>);
+static_assert(!std::convertible_to<decltype(lazy(std::declval<const position&>())), velocity>);
+
+// A truncating unit conversion of an integral expression is rejected.
+static_assert(
+  std::convertible_to<lazy_quantity<isq::displacement[m], const ivec&>, quantity<isq::displacement[mm], ivec>>);
+static_assert(
+  !std::convertible_to<lazy_quantity<isq::displacement[mm], const ivec&>, quantity<isq::displacement[m], ivec>>);
+
+}  // namespace
+
+TEST_CASE("lazy quantity arithmetic", "[lazy_quantity]")
+{
+  constexpr std::size_t size = 16;
+  const position x(make_vec(size, 1., 1.), isq::displacement[m]);
+  const velocity v(make_vec(size, 2., -0.5), isq::velocity[m / s]);
+
+  SECTION("linear combination")
+  {
+    const quantity dt = 0.25 * isq::duration[s];
+    const position r = lazy(x) + dt * lazy(v);
+    for (std::size_t i = 0; i < size; ++i)
+      CHECK_THAT(at(r.numerical_value_in(m), i),
+                 WithinRel(at(x.numerical_value_in(m), i) + 0.25 * at(v.numerical_value_in(m / s), i)));
+  }
+
+  SECTION("unit conversions are folded into the expression")
+  {
+    const quantity<isq::displacement[km], vec> x_km(make_vec(size, 1., 0.), isq::displacement[km]);
+    const quantity<isq::displacement[cm], vec> r = lazy(x) - lazy(x_km) + lazy(v) * (500. * ms);
+    for (std::size_t i = 0; i < size; ++i)
+      CHECK_THAT(at(r.numerical_value_in(cm), i),
+                 WithinRel(100. * (at(x.numerical_value_in(m), i) - 1000. + 0.5 * at(v.numerical_value_in(m / s), i))));
+  }
+
+  SECTION("evaluation into an existing quantity")
+  {
+    position r(make_vec(size, 0., 0.), isq::displacement[m]);
+    (2. * lazy(x) - lazy(x) / 4.).evaluate_into(r);
+    for (std::size_t i = 0; i < size; ++i)
+      CHECK_THAT(at(r.numerical_value_in(m), i), WithinRel(1.75 * at(x.numerical_value_in(m), i)));
+  }
+
+  SECTION("eval")
+  {
+    const quantity a = (-lazy(v) / (2. * s)).eval();
+    static_assert(std::same_as<std::remove_cvref_t<decltype(a)>::rep, vec>);
+    static_assert(a.quantity_spec == isq::velocity / isq::duration);
+    for (std::size_t i = 0; i < size; ++i)
+      CHECK_THAT(at(a.numerical_value_in(m / s2), i), WithinRel(-0.5 * at(v.numerical_value_in(m / s), i)));
+  }
+}
+
+TEST_CASE("lazy quantity benchmark", "[.][benchmark][lazy_quantity]")
+{
+  constexpr std::size_t size = 1 << 20;
+  const position qx(make_vec(size, 1., 1e-3), isq::displacement[m]);
+  const velocity qy(make_vec(size, -1., 2e-3), isq::velocity[m / s]);
+  position qz(make_vec(size, 0., 0.), isq::displacement[m]);
+  const quantity qa = 0.5 * one;
+  const quantity qb = 2. * isq::duration[s];
+
+  // the raw baseline works on the very same storage
+  const double a = qa.numerical_value_in(one);
+  const double b = qb.numerical_value_in(s);
+  const vec& x = qx.numerical_value_ref_in(m);
+  const vec& y = qy.numerical_value_ref_in(m / s);
+  vec& z = qz.numerical_value_ref_in(m);
+
+  BENCHMARK("raw: z = a * x + b * y")
+  {
+#if defined(MP_UNITS_LA_EIGEN)
+    z.noalias() = a * x + b * y;
+#else
+    z = a * x + b * y;
+#endif
+    return at(z, 0);
+  };
+
+  BENCHMARK("eager quantities: z = a * x + b * y")
+  {
+    qz = qa * qx + qb * qy;
+    return at(qz.numerical_value_ref_in(m), 0);
+  };
+
+  BENCHMARK("lazy quantities: z = a * lazy(x) + b * lazy(y)")
+  {
+    qz = qa * lazy(qx) + qb * lazy(qy);
+    return at(qz.numerical_value_ref_in(m), 0);
+  };
+
+  BENCHMARK("lazy quantities: (a * lazy(x) + b * lazy(y)).evaluate_into(z)")
+  {
+    (qa * lazy(qx) + qb * lazy(qy)).evaluate_into(qz);
+    return at(qz.numerical_value_ref_in(m), 0);
+  };
+}
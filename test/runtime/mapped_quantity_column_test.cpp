@@ -0,0 +1,197 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#include <mp-units/utility/column_codec.h>
+#include <mp-units/utility/mapped_quantity_column.h>
+#endif
+
+#if MP_UNITS_HAS_MMAP
+
+using namespace mp_units;
+using namespace mp_units::utility;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+// a column file removed at the end of the test
+class temp_column_file {
+  std::filesystem::path path_;
+public:
+  template<typename... Ts>
+  explicit temp_column_file(const std::string& name, const std::vector<Ts>&... columns) :
+      path_(std::filesystem::temp_directory_path() / name)
+  {
+    std::ofstream os(path_, std::ios::binary);
+    write_columns(os, std::span<const Ts>(columns)...);
+  }
+  ~temp_column_file() { std::filesystem::remove(path_); }
+  [[nodiscard]] const std::filesystem::path& path() const { return path_; }
+};
+
+template<typename T>
+std::vector<T> iota_column(std::size_t n, auto unit)
+{
+  std::vector<T> res;
+  res.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) res.emplace_back(static_cast<typename T::rep>(i) * unit);
+  return res;
+}
+
+}  // namespace
+
+TEST_CASE("mapped_quantity_column exposes a column in place", "[mapped_quantity_column]")
+{
+  const auto lengths = iota_column<quantity<km, double>>(100'000, km);
+  const auto counts = iota_column<quantity<one, std::int16_t>>(10, one);
+  const temp_column_file file("mp_units_mapped_in_place.mpuc", lengths, counts);
+
+  const mapped_quantity_column<quantity<km, double>> column(file.path());
+  REQUIRE(column.in_place());
+  REQUIRE(column.size() == lengths.size());
+  CHECK(column.values()[0] == 0. * km);
+  CHECK(column.values()[99'999] == 99'999. * km);
+  CHECK(std::ranges::equal(column.values(), lengths));
+
+  const mapped_quantity_column<quantity<one, std::int16_t>> second(file.path(), 1);
+  CHECK(std::ranges::equal(second.values(), counts));
+
+  SECTION("chunks end on page boundaries and cover the column")
+  {
+    column.advise(column_access::sequential);
+    std::size_t count = 0;
+    std::size_t chunks = 0;
+    column.for_each_chunk(
+      [&](std::span<const quantity<km, double>> chunk) {
+        CHECK(chunk.data() == column.values().data() + count);
+        if (count + chunk.size() < column.size())
+          CHECK(reinterpret_cast<std::uintptr_t>(chunk.data() + chunk.size()) % column.page_size() == 0);
+        count += chunk.size();
+        ++chunks;
+      },
+      1);
+    CHECK(count == column.size());
+    CHECK(chunks >= column.size() * sizeof(double) / column.page_size());
+  }
+
+  SECTION("a moved-from column is empty")
+  {
+    mapped_quantity_column<quantity<km, double>> source(file.path());
+    mapped_quantity_column<quantity<km, double>> target(std::move(source));
+    CHECK(target.size() == lengths.size());
+    CHECK(source.empty());
+    CHECK_FALSE(source.in_place());
+
+    source = std::move(target);
+    CHECK(std::ranges::equal(source.values(), lengths));
+    CHECK(target.empty());
+    std::size_t chunks = 0;
+    target.for_each_chunk([&](std::span<const quantity<km, double>>) { ++chunks; });
+    CHECK(chunks == 0);
+  }
+}
+
+TEST_CASE("mapped_quantity_column converts lazily to the requested unit", "[mapped_quantity_column]")
+{
+  const auto lengths = iota_column<quantity<km, std::int32_t>>(10'000, km);
+  const temp_column_file file("mp_units_mapped_converted.mpuc", lengths);
+
+  const mapped_quantity_column<quantity<m, double>> column(file.path());
+  REQUIRE_FALSE(column.in_place());
+  CHECK(column[0] == 0. * m);
+  CHECK(column[1234] == 1'234'000. * m);
+
+  std::size_t count = 0;
+  column.for_each_chunk([&](std::span<const quantity<m, double>> chunk) {
+    for (const auto& q : chunk) CHECK(q == static_cast<double>(count++) * km);
+  });
+  CHECK(count == lengths.size());
+}
+
+TEST_CASE("mapped_quantity_column validates the column", "[mapped_quantity_column]")
+{
+  const std::vector lengths = {1. * km};
+  const temp_column_file file("mp_units_mapped_invalid.mpuc", lengths);
+
+  CHECK_THROWS_AS((mapped_quantity_column<quantity<s, double>>(file.path())), std::invalid_argument);
+  CHECK_THROWS_AS((mapped_quantity_column<quantity<m, std::int64_t>>(file.path())), std::invalid_argument);
+  CHECK_THROWS_AS((mapped_quantity_column<quantity<m, double>>(file.path(), 1)), std::out_of_range);
+  CHECK_THROWS_AS((mapped_quantity_column<quantity<m, double>>(file.path().string() + ".missing")), std::system_error);
+  try {
+    (void)mapped_quantity_column<quantity<m, double>>(file.path().string() + ".missing");
+  } catch (const std::system_error& e) {
+    CHECK(e.code() == std::errc::no_such_file_or_directory);
+  }
+}
+
+TEST_CASE("mapped_quantity_column throughput", "[.][benchmark][mapped_quantity_column]")
+{
+  const auto lengths = iota_column<quantity<km, double>>(1 << 22, km);
+  const temp_column_file file("mp_units_mapped_benchmark.mpuc", lengths);
+
+  BENCHMARK("column_reader")
+  {
+    std::ifstream is(file.path(), std::ios::binary);
+    quantity<km, double> sum{};
+    for (const auto& q : column_reader(is).read<quantity<km, double>>(0)) sum += q;
+    return sum;
+  };
+  BENCHMARK("mapped in place")
+  {
+    const mapped_quantity_column<quantity<km, double>> column(file.path());
+    quantity<km, double> sum{};
+    column.for_each_chunk([&](auto chunk) {
+      for (const auto& q : chunk) sum += q;
+    });
+    return sum;
+  };
+  BENCHMARK("mapped converted")
+  {
+    const mapped_quantity_column<quantity<m, double>> column(file.path());
+    quantity<m, double> sum{};
+    column.for_each_chunk([&](auto chunk) {
+      for (const auto& q : chunk) sum += q;
+    });
+    return sum;
+  };
+}
+
+#endif  // MP_UNITS_HAS_MMAP
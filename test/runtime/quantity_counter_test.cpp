@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <catch2/catch_test_macros.hpp>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/iec.h>
+#include <mp-units/systems/si.h>
+#include <mp-units/utility/quantity_counter.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::utility;
+using namespace std::chrono_literals;
+
+namespace {
+
+using byte_counter = quantity_counter<quantity<iec::byte, std::uint64_t>>;
+using time_point = byte_counter::clock::time_point;
+
+// every reading is one nanosecond later than the previous one, so no window is ever empty
+struct tick_clock {
+  using rep = std::int64_t;
+  using period = std::nano;
+  using duration = std::chrono::nanoseconds;
+  using time_point = std::chrono::time_point<tick_clock>;
+  static constexpr bool is_steady = true;
+  static inline std::atomic<rep> ticks{0};
+  static time_point now() noexcept { return time_point{duration{++ticks}}; }
+};
+
+}  // namespace
+
+TEST_CASE("quantity_counter", "[quantity_counter]")
+{
+  const time_point start{};
+
+  SECTION("total")
+  {
+    byte_counter c(start);
+    c += 1u * iec::kibi<iec::byte>;
+    c.add(24u * iec::byte);
+    CHECK(c.total() == 1048u * iec::byte);
+  }
+
+  SECTION("rate over consecutive windows")
+  {
+    byte_counter c(start);
+    static_assert(std::is_same_v<byte_counter::rate_type, quantity<iec::byte / si::second, double>>);
+
+    c += 2u * iec::mebi<iec::byte>;
+    CHECK(c.rate(start + 2s) == 1024. * 1024. * iec::byte / si::second);
+
+    c += 500u * iec::byte;
+    CHECK(c.rate(start + 2s + 250ms) == 2000. * iec::byte / si::second);
+
+    CHECK(c.rate(start + 3s) == 0. * iec::byte / si::second);
+    CHECK(c.rate(start + 3s) == 0. * iec::byte / si::second);  // empty window
+  }
+
+  SECTION("unsigned wrap-around")
+  {
+    quantity_counter<quantity<iec::byte, std::uint8_t>, 1> c(start);
+    c += quantity<iec::byte, std::uint8_t>{std::uint8_t{200}, iec::byte};
+    (void)c.rate(start + 1s);
+    c += quantity<iec::byte, std::uint8_t>{std::uint8_t{100}, iec::byte};
+    CHECK(c.total() == quantity<iec::byte, std::uint8_t>{std::uint8_t{44}, iec::byte});
+    CHECK(c.rate(start + 2s) == 100. * iec::byte / si::second);
+  }
+
+  SECTION("concurrent updates")
+  {
+    byte_counter c(start);
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 16; ++i)
+      writers.emplace_back([&] {
+        for (int j = 0; j < 10'000; ++j) c += 1500u * iec::byte;
+      });
+    for (auto& t : writers) t.join();
+    CHECK(c.total() == 16u * 10'000u * 1500u * iec::byte);
+    CHECK(c.rate(start + 1s) == 240'000'000. * iec::byte / si::second);
+  }
+
+  SECTION("concurrent rate readers")
+  {
+    quantity_counter<quantity<iec::byte, std::uint64_t>, 128, tick_clock> c;
+    constexpr auto bytes = 16u * 10'000u * 1500u * iec::byte;
+    // a window spans at least one tick, so no window can report more than all the bytes in 1 ns
+    constexpr auto max_rate = bytes.in(iec::byte) / (1. * si::nano<si::second>);
+    std::atomic<bool> too_fast{false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 16; ++i)
+      threads.emplace_back([&] {
+        for (int j = 0; j < 10'000; ++j) c += 1500u * iec::byte;
+      });
+    for (int i = 0; i < 4; ++i)
+      threads.emplace_back([&] {
+        for (int j = 0; j < 10'000; ++j)
+          if (c.rate() > max_rate) too_fast = true;
+      });
+    for (auto& t : threads) t.join();
+    CHECK_FALSE(too_fast);
+    CHECK(c.total() == bytes);
+  }
+}
@@ -0,0 +1,155 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#include <mp-units/utility/quantity_histogram.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::utility;
+using namespace mp_units::si::unit_symbols;
+
+namespace {
+
+using latency = quantity<ns, std::int64_t>;
+using latency_histogram = quantity_histogram<latency, 4>;
+using buckets = latency_histogram::buckets;
+
+// every bucket holds the values from the previous bucket's highest value (exclusive) to its own
+constexpr bool buckets_are_contiguous()
+{
+  for (std::size_t i = 1; i < buckets::size; ++i) {
+    const std::uint64_t first = buckets::highest_value_of(i - 1) + 1;
+    if (buckets::index_of(first) != i || buckets::index_of(buckets::highest_value_of(i)) != i) return false;
+  }
+  return true;
+}
+
+static_assert(buckets::size == 60 * 32);
+static_assert(buckets::index_of(0) == 0);
+static_assert(buckets::index_of(63) == 63);
+static_assert(buckets::index_of(64) == 64);
+static_assert(buckets::index_of(65) == 64);
+static_assert(buckets::highest_value_of(64) == 65);
+static_assert(buckets::index_of(UINT64_MAX) == buckets::size - 1);
+static_assert(buckets::highest_value_of(buckets::size - 1) == UINT64_MAX);
+static_assert(buckets_are_contiguous());
+
+}  // namespace
+
+TEST_CASE("quantity_histogram", "[quantity_histogram]")
+{
+  auto h = std::make_unique<latency_histogram>();
+
+  SECTION("exact in the linear range")
+  {
+    for (std::int64_t i = 1; i <= 50; ++i) h->record(latency{i, ns});
+    const auto s = h->snapshot();
+    CHECK(s.count() == 50);
+    CHECK(s.percentile(0.) == 1 * ns);
+    CHECK(s.percentile(50.) == 25 * ns);
+    CHECK(s.percentile(90.) == 45 * ns);
+    CHECK(s.percentile(100.) == 50 * ns);
+  }
+
+  SECTION("relative resolution above the linear range")
+  {
+    h->record(12 * us);
+    h->record(3 * ms);
+    const auto s = h->snapshot();
+    const latency p50 = s.percentile(50.);
+    CHECK(p50 >= 12 * us);
+    CHECK(p50 < 12'000 * ns * 33 / 32);
+    const latency p100 = s.percentile(100.);
+    CHECK(p100 >= 3 * ms);
+    CHECK(p100 < 3'000'000 * ns * 33 / 32);
+  }
+
+  SECTION("merging snapshots")
+  {
+    auto other = std::make_unique<latency_histogram>();
+    h->record(1 * ns);
+    other->record(2 * ns);
+    other->record(3 * ns);
+    const auto merged = h->snapshot() + other->snapshot();
+    CHECK(merged.count() == 3);
+    CHECK(merged.percentile(100.) == 3 * ns);
+
+    histogram_snapshot<latency> expected;
+    expected.record(1 * ns);
+    expected.record(2 * ns);
+    expected.record(3 * ns);
+    CHECK(merged == expected);
+  }
+
+  SECTION("exchange_zero")
+  {
+    h->record(1 * ns);
+    CHECK(h->exchange_zero().count() == 1);
+    CHECK(h->snapshot().count() == 0);
+  }
+
+  SECTION("concurrent recording")
+  {
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 8; ++i)
+      writers.emplace_back([&] {
+        for (std::int64_t j = 0; j < 10'000; ++j) h->record(latency{j % 100, ns});
+      });
+    for (auto& t : writers) t.join();
+    const auto s = h->snapshot();
+    CHECK(s.count() == 80'000);
+    CHECK(s.percentile(100.) == 99 * ns);
+  }
+}
+
+TEST_CASE("quantity_histogram benchmark", "[.][benchmark][quantity_histogram]")
+{
+  constexpr std::size_t size = 10'000'000;
+  std::vector<latency> samples(size);
+  std::uint64_t state = 42;
+  for (latency& q : samples) {
+    state = state * 6364136223846793005u + 1442695040888963407u;
+    q = latency{static_cast<std::int64_t>(state >> 44), ns};  // up to ~1 ms
+  }
+  auto h = std::make_unique<latency_histogram>();
+
+  BENCHMARK("record 10M samples")
+  {
+    for (const latency& q : samples) h->record(q);
+    return h->snapshot().count();
+  };
+}
@@ -0,0 +1,237 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Exercises the sparse matrices of a third-party linear algebra library used as an mp-units
+// `quantity` representation type: unit-typed sparse mat-vec products and (with Eigen) iterative
+// solvers. Like `linear_algebra_test`, the backend is selected from whichever library is available on
+// the include path, and the build system compiles this file once per library it finds.
+
+#if __has_include(<Eigen/Core>)
+#include <Eigen/Core>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCore>
+#define MP_UNITS_LA_EIGEN
+#elif __has_include(<blaze/math/CompressedMatrix.h>)
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/DynamicVector.h>
+#define MP_UNITS_LA_BLAZE
+#endif
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#endif
+
+#include <mp-units/systems/isq/mechanics.h>
+#include <mp-units/systems/isq/space_and_time.h>
+#include <mp-units/systems/si.h>
+#if defined(MP_UNITS_LA_EIGEN)
+#include <mp-units/integrations/eigen.h>
+#elif defined(MP_UNITS_LA_BLAZE)
+#include <mp-units/integrations/blaze.h>
+#endif
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::si::unit_symbols;
+using Catch::Matchers::WithinRel;
+
+// The stiffness matrix of a discretized structure maps nodal displacements to nodal forces.
+QUANTITY_SPEC(stiffness, isq::force / isq::displacement, quantity_tensor_order::tensor);
+
+#if defined(MP_UNITS_LA_EIGEN)
+using sparse_matrix = Eigen::SparseMatrix<double>;
+using vec = Eigen::VectorXd;
+#elif defined(MP_UNITS_LA_BLAZE)
+using sparse_matrix = blaze::CompressedMatrix<double>;
+using vec = blaze::DynamicVector<double>;
+#endif
+
+// A chain of `size` nodes connected with springs of stiffness `k`, each node also anchored to the
+// ground with a spring of stiffness `k0` (tridiagonal, symmetric, and positive definite).
+[[nodiscard]] sparse_matrix make_chain(std::size_t size, double k, double k0)
+{
+#if defined(MP_UNITS_LA_EIGEN)
+  std::vector<Eigen::Triplet<double>> entries;
+  entries.reserve(3 * size);
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto r = static_cast<Eigen::Index>(i);
+    if (i > 0) entries.emplace_back(r, r - 1, -k);
+    entries.emplace_back(r, r, 2 * k + k0);
+    if (i + 1 < size) entries.emplace_back(r, r + 1, -k);
+  }
+  sparse_matrix res(static_cast<Eigen::Index>(size), static_cast<Eigen::Index>(size));
+  res.setFromTriplets(entries.begin(), entries.end());
+  return res;
+#elif defined(MP_UNITS_LA_BLAZE)
+  sparse_matrix res(size, size);
+  res.reserve(3 * size);
+  for (std::size_t i = 0; i < size; ++i) {
+    if (i > 0) res.append(i, i - 1, -k);
+    res.append(i, i, 2 * k + k0);
+    if (i + 1 < size) res.append(i, i + 1, -k);
+    res.finalize(i);
+  }
+  return res;
+#endif
+}
+
+[[nodiscard]] vec make_vec(std::size_t size, double first, double step)
+{
+  vec res(size);
+  for (std::size_t i = 0; i < size; ++i)
+    res[static_cast<decltype(res.size())>(i)] = first + step * static_cast<double>(i);
+  return res;
+}
+
+[[nodiscard]] double at(const vec& v, std::size_t i) { return v[static_cast<decltype(v.size())>(i)]; }
+
+// --- compile-time guarantees -------------------------------------------------------------------
+
+// A sparse matrix is a tensor representation, so it can store a stiffness matrix.
+static_assert(RepresentationOf<sparse_matrix, quantity_tensor_order::tensor>);
+static_assert(RepresentationOf<sparse_matrix, stiffness>);
+static_assert(!RepresentationOf<sparse_matrix, isq::force>);
+
+// A sparse mat-vec product stores the dense vector, and arithmetic on a sparse quantity keeps the
+// sparse type (rather than a proxy or a dense temporary).
+static_assert(std::same_as<decltype(std::declval<quantity<stiffness[N / m], sparse_matrix>>() *
+                                    std::declval<quantity<isq::displacement[m], vec>>())::rep,
+                           vec>);
+static_assert(
+  std::same_as<decltype(2. * std::declval<quantity<stiffness[N / m], sparse_matrix>>())::rep, sparse_matrix>);
+static_assert(std::same_as<decltype(std::declval<quantity<stiffness[N / m], sparse_matrix>>() +
+                                    std::declval<quantity<stiffness[N / m], sparse_matrix>>())::rep,
+                           sparse_matrix>);
+
+#if defined(MP_UNITS_LA_EIGEN)
+static_assert(RepresentationOf<Eigen::SparseVector<double>, quantity_tensor_order::vector>);
+static_assert(RepresentationOf<Eigen::SparseVector<double>, isq::force>);
+static_assert(std::same_as<representation_canonical_type_t<decltype(std::declval<Eigen::SparseVector<double>>() * 2.)>,
+                           Eigen::SparseVector<double>>);
+#endif
+
+}  // namespace
+
+TEST_CASE("sparse matrix quantities", "[sparse][linear_algebra]")
+{
+  constexpr std::size_t size = 64;
+  const quantity<stiffness[kN / m], sparse_matrix> k(make_chain(size, 2., 1.), stiffness[kN / m]);
+  const quantity<isq::displacement[mm], vec> u(make_vec(size, 1., 0.5), isq::displacement[mm]);
+
+  SECTION("mat-vec product")
+  {
+    const quantity<isq::force[N], vec> f = k * u;
+    for (std::size_t i = 0; i < size; ++i) {
+      double expected = 5. * at(u.numerical_value_in(mm), i);
+      if (i > 0) expected -= 2. * at(u.numerical_value_in(mm), i - 1);
+      if (i + 1 < size) expected -= 2. * at(u.numerical_value_in(mm), i + 1);
+      CHECK_THAT(at(f.numerical_value_in(N), i), WithinRel(expected));
+    }
+  }
+
+  SECTION("arithmetic and comparison")
+  {
+    const quantity k2 = k + k;
+    CHECK(k2 == 2. * k);
+    CHECK(k2 != k);
+    CHECK(k2 / 2. == k);
+    CHECK(k.in(N / m) == k);
+  }
+
+#if defined(MP_UNITS_LA_EIGEN)
+  SECTION("conjugate gradient")
+  {
+    const quantity<isq::force[N], vec> f = k * u;
+    Eigen::ConjugateGradient<sparse_matrix, Eigen::Lower | Eigen::Upper> solver;
+    const quantity<isq::displacement[mm], vec> x = solve(solver, k, f);
+    REQUIRE(solver.info() == Eigen::Success);
+    for (std::size_t i = 0; i < size; ++i)
+      CHECK_THAT(at(x.numerical_value_in(mm), i), WithinRel(at(u.numerical_value_in(mm), i), 1e-9));
+  }
+
+  SECTION("BiCGSTAB with an initial guess")
+  {
+    const quantity<isq::force[kN], vec> f = k * u;
+    const quantity<isq::displacement[m], vec> guess(make_vec(size, 0., 0.), isq::displacement[m]);
+    Eigen::BiCGSTAB<sparse_matrix> solver;
+    const quantity<isq::displacement[mm], vec> x = solve(solver, k, f, guess);
+    REQUIRE(solver.info() == Eigen::Success);
+    for (std::size_t i = 0; i < size; ++i)
+      CHECK_THAT(at(x.numerical_value_in(mm), i), WithinRel(at(u.numerical_value_in(mm), i), 1e-9));
+  }
+#endif
+}
+
+TEST_CASE("sparse matrix quantities benchmark", "[.][benchmark][sparse]")
+{
+  for (const std::size_t size : {std::size_t{10'000}, std::size_t{100'000}, std::size_t{1'000'000}}) {
+    const std::string dofs = std::to_string(size) + " DOF";
+    const quantity<stiffness[N / m], sparse_matrix> k(make_chain(size, 2., 1.), stiffness[N / m]);
+    const quantity<isq::displacement[m], vec> u(make_vec(size, 1., 1e-6), isq::displacement[m]);
+    const sparse_matrix& raw_k = k.numerical_value_ref_in(N / m);
+    const vec& raw_u = u.numerical_value_ref_in(m);
+
+    BENCHMARK("raw mat-vec, " + dofs)
+    {
+      const vec f = raw_k * raw_u;
+      return at(f, 0);
+    };
+
+    BENCHMARK("quantity mat-vec, " + dofs)
+    {
+      const quantity<isq::force[N], vec> f = k * u;
+      return at(f.numerical_value_ref_in(N), 0);
+    };
+
+#if defined(MP_UNITS_LA_EIGEN)
+    const quantity<isq::force[N], vec> f = k * u;
+    const vec& raw_f = f.numerical_value_ref_in(N);
+
+    BENCHMARK("raw conjugate gradient, " + dofs)
+    {
+      Eigen::ConjugateGradient<sparse_matrix, Eigen::Lower | Eigen::Upper> solver(raw_k);
+      solver.setTolerance(1e-10);
+      const vec x = solver.solve(raw_f);
+      return at(x, 0);
+    };
+
+    BENCHMARK("quantity conjugate gradient, " + dofs)
+    {
+      Eigen::ConjugateGradient<sparse_matrix, Eigen::Lower | Eigen::Upper> solver;
+      solver.setTolerance(1e-10);
+      const quantity<isq::displacement[m], vec> x = solve(solver, k, f);
+      return at(x.numerical_value_ref_in(m), 0);
+    };
+#endif
+  }
+}
@@ -0,0 +1,80 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch_test_macros.hpp>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <thread>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#include <mp-units/utility/tsc_clock.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::utility;
+using namespace mp_units::si::unit_symbols;
+using namespace std::chrono_literals;
+
+namespace {
+
+// timestamps subtract to a number of cycles, which is not a time until it is calibrated
+static_assert(std::same_as<decltype(tsc_clock::now() - tsc_clock::now()), tsc_clock::duration>);
+static_assert(std::same_as<tsc_clock::duration::rep, std::uint64_t>);
+static_assert(!std::convertible_to<tsc_clock::duration, quantity<ns, std::uint64_t>>);
+static_assert(!std::convertible_to<tsc_clock::duration, quantity<one, std::uint64_t>>);
+static_assert(!std::convertible_to<quantity<ns, std::uint64_t>, tsc_clock::duration>);
+
+}  // namespace
+
+TEST_CASE("tsc_clock", "[tsc_clock]")
+{
+  SECTION("the counter is monotonic")
+  {
+    const tsc_clock::time_point t0 = tsc_clock::now();
+    const tsc_clock::time_point t1 = tsc_clock::now();
+    CHECK(t1 >= t0);
+  }
+
+  SECTION("calibrated period")
+  {
+    const tsc_clock::period_type& p = tsc_clock::period();
+    CHECK(p.period() > 0. * ns);
+    CHECK(&p == &tsc_clock::period());  // calibrated once
+  }
+
+  SECTION("cycles convert to time only when reported")
+  {
+    const tsc_clock::time_point start = tsc_clock::now();
+    std::this_thread::sleep_for(20ms);
+    const tsc_clock::duration cycles = tsc_clock::now() - start;
+    const quantity elapsed = tsc_clock::to_duration(cycles);
+    CHECK(elapsed >= 15 * ms);
+    CHECK(elapsed < 10 * s);
+  }
+}
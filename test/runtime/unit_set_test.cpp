@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#endif
+#ifdef MP_UNITS_MODULES
+import mp_units;
+#else
+#include <mp-units/systems/si.h>
+#include <mp-units/systems/yard_pound.h>
+#include <mp-units/utility/unit_set.h>
+#endif
+
+using namespace mp_units;
+using namespace mp_units::utility;
+using namespace mp_units::si::unit_symbols;
+using namespace mp_units::yard_pound::unit_symbols;
+
+namespace {
+
+using Catch::Matchers::WithinULP;
+
+using lengths = unit_set<si::metre, si::kilo<si::metre>, yard_pound::foot, yard_pound::mile>;
+using angles = unit_set<si::radian, si::degree>;
+
+// the factors are computed at compile time
+static_assert(lengths::size == 4);
+static_assert(lengths::index_of(si::kilo<si::metre>) == 1);
+static_assert(lengths::factor(1, 0).integral() && lengths::factor(1, 0).num == 1000);
+static_assert(lengths::factor(0, 1).exact() && lengths::factor(0, 1).num == 1 && lengths::factor(0, 1).den == 1000);
+static_assert(lengths::factor(2, 0).num == 381 && lengths::factor(2, 0).den == 1250);
+static_assert(lengths::factor(3, 2).integral() && lengths::factor(3, 2).num == 5280);
+static_assert(lengths::factor(2, 2).integral() && lengths::factor(2, 2).num == 1);
+static_assert(!angles::factor(0, 1).exact());
+static_assert(lengths::convert(std::int64_t{3}, lengths::index_of(si::kilo<si::metre>), lengths::index_of(si::metre)) ==
+              3000);
+
+}  // namespace
+
+TEST_CASE("unit_set symbols", "[unit_set]")
+{
+  CHECK(lengths::symbol(0) == "m");
+  CHECK(lengths::symbol(1) == "km");
+  CHECK(lengths::symbol(2) == "ft");
+  CHECK(lengths::symbol(3) == "mi");
+  CHECK(lengths::find("ft") == 2);
+  CHECK_FALSE(lengths::find("yd").has_value());
+}
+
+TEST_CASE("unit_set converts to a runtime-selected unit", "[unit_set]")
+{
+  const std::size_t metre = lengths::find("m").value();
+
+  SECTION("floating-point")
+  {
+    CHECK_THAT(lengths::convert(1. * mi, metre), WithinULP(1609.344, 1));
+    CHECK_THAT(lengths::convert(1. * m, lengths::index_of(yard_pound::foot)), WithinULP(1. / 0.3048, 1));
+    CHECK_THAT(angles::convert(180. * deg, angles::index_of(si::radian)), WithinULP(3.141592653589793, 1));
+  }
+
+  SECTION("integral values use the exact factor")
+  {
+    CHECK(lengths::convert(2 * km, metre) == 2000);
+    CHECK(lengths::convert(10'000 * ft, metre) == 3048);
+    CHECK(lengths::convert(std::int64_t{1} * mi, lengths::index_of(yard_pound::foot)) == 5280);
+    CHECK(lengths::convert(1999 * m, lengths::index_of(si::kilo<si::metre>)) == 1);
+  }
+
+  SECTION("large integral values do not overflow the intermediate product")
+  {
+    // 10^18 * 381 overflows 64 bits before the division by 1250
+    CHECK(lengths::convert(std::int64_t{1'000'000'000'000'000'000} * ft, metre) == 304'800'000'000'000'000);
+    CHECK(lengths::convert(std::int64_t{-1'000'000'000'000'000'000} * ft, metre) == -304'800'000'000'000'000);
+
+    // a numerator above `INT64_MAX`
+    using huge = unit_set<si::metre, mag_power<10, 19> * si::metre>;
+    static_assert(huge::factor(1, 0).integral() && huge::factor(1, 0).num == 10'000'000'000'000'000'000u);
+    CHECK(huge::convert(std::uint64_t{1}, 1, 0) == 10'000'000'000'000'000'000u);
+  }
+}
+
+TEST_CASE("unit_set converts batches", "[unit_set]")
+{
+  const std::vector values = {1. * km, 2.5 * km, 42. * km};
+  std::vector<double> out(values.size());
+  lengths::convert(std::span{values}, lengths::index_of(si::metre), std::span{out});
+  CHECK(out == std::vector{1000., 2500., 42000.});
+
+  const std::vector<std::int32_t> feet = {0, 1250, 2500};
+  std::vector<std::int32_t> metres(feet.size());
+  lengths::convert(std::span{feet}, lengths::index_of(yard_pound::foot), lengths::index_of(si::metre),
+                   std::span{metres});
+  CHECK(metres == std::vector<std::int32_t>{0, 381, 762});
+}
+
+TEST_CASE("unit_set throughput", "[.][benchmark][unit_set]")
+{
+  std::vector<double> values(1 << 20);
+  for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<double>(i);
+  std::vector<double> out(values.size());
+  const std::size_t to = lengths::find("ft").value();
+
+  BENCHMARK("switch over quantity::in")
+  {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      const quantity q = values[i] * km;
+      switch (to) {
+        case 0: out[i] = q.numerical_value_in(m); break;
+        case 1: out[i] = q.numerical_value_in(km); break;
+        case 2: out[i] = q.numerical_value_in(ft); break;
+        default: out[i] = q.numerical_value_in(mi); break;
+      }
+    }
+    return out.back();
+  };
+  BENCHMARK("unit_set")
+  {
+    lengths::convert(std::span<const double>{values}, lengths::index_of(si::kilo<si::metre>), to, std::span{out});
+    return out.back();
+  };
+}
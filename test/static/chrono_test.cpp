@@ -30,6 +30,7 @@ import std;
 #else
 #include <chrono>
 #include <concepts>
+#include <cstdint>
 #include <ratio>
 #endif
 
@@ -174,4 +175,20 @@ static_assert(is_same_v<decltype(to_chrono_duration(3 * ns))::period, std::nano>
 static_assert(to_chrono_time_point(quantity_point{sys_seconds{1s}}) == sys_seconds{1s});
 static_assert(to_chrono_time_point(quantity_point{sys_days{sys_days::duration{1}}}) == sys_days{sys_days::duration{1}});
 
+// sub-nanosecond and arbitrary periods
+static_assert(is_of_type<quantity{std::chrono::duration<int, std::pico>{1}}, quantity<si::pico<si::second>, int>>);
+static_assert(is_of_type<quantity{std::chrono::duration<int, std::atto>{1}}, quantity<si::atto<si::second>, int>>);
+static_assert(quantity{std::chrono::duration<int, std::ratio<1, 3>>{1}} == 1 * s / 3.);
+static_assert(to_chrono_duration(quantity{std::chrono::duration<int, std::femto>{4}}) ==
+              std::chrono::duration<int, std::femto>{4});
+
+// tick_period
+static_assert(tick_period<ns>(0.25 * ns)(8) == 2. * ns);
+static_assert(tick_period<ns>(4. * si::giga<si::hertz>)(8) == 2. * ns);
+static_assert(tick_period<ns>(4 * si::giga<si::hertz>)(std::uint64_t{8}) == 2. * ns);
+static_assert(tick_period<s, float>(1 * ms).period() == 0.001f * s);
+static_assert(is_of_type<tick_period<ns>(1. * ns)(1), quantity<ns, double>>);
+static_assert(is_of_type<tick_period<isq::duration[ns]>(1. * ns)(1), quantity<isq::duration[ns], double>>);
+static_assert(!std::constructible_from<tick_period<ns>, quantity<m>>);
+
 }  // namespace
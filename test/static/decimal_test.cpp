@@ -0,0 +1,180 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <mp-units/framework/customization_points.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/representation_concepts.h>
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#include <mp-units/utility/decimal.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#endif
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::utility;
+using namespace mp_units::si::unit_symbols;
+
+using dec2 = decimal<std::int64_t, 2>;
+using dec4 = decimal<std::int64_t, 4>;
+using dec2_up = decimal<std::int64_t, 2, round_half_up>;
+using dec2_trunc = decimal<std::int64_t, 2, round_toward_zero>;
+
+// clang-format off
+inline constexpr struct dim_currency final : base_dimension<"$"> {} dim_currency;
+QUANTITY_SPEC(currency, dim_currency);
+inline constexpr struct us_dollar final : named_unit<"USD", kind_of<currency>> {} us_dollar;
+inline constexpr struct us_cent final : named_unit<"USc", mag_ratio<1, 100> * us_dollar> {} us_cent;
+inline constexpr struct us_mill final : named_unit<"mill", mag_ratio<1, 1000> * us_dollar> {} us_mill;
+// clang-format on
+
+// ============================================================================
+// Representation concepts
+// ============================================================================
+
+static_assert(RepresentationOf<dec2, quantity_tensor_order::scalar>);
+static_assert(RepresentationOf<dec2, quantity_field::real>);
+static_assert(RepresentationOf<dec2, currency>);
+static_assert(mp_units::detail::UsesUnitMagnitudeAwareScaling<dec2>);
+static_assert(!treat_as_floating_point<dec2>);
+static_assert(std::is_same_v<dec2::value_type, std::int64_t>);
+static_assert(sizeof(dec2) == sizeof(std::int64_t));
+static_assert(std::is_trivially_copyable_v<dec2>);
+
+// ============================================================================
+// Construction and conversion
+// ============================================================================
+
+static_assert(dec2{3}.raw_value() == 300);
+static_assert(dec2{-3}.raw_value() == -300);
+static_assert(dec2{1.25}.raw_value() == 125);
+static_assert(dec2{0.125}.raw_value() == 12);   // half-even: 12.5 -> 12
+static_assert(dec2{0.135}.raw_value() == 14);   // half-even: 13.5 -> 14
+static_assert(dec2_up{0.125}.raw_value() == 13);
+static_assert(dec2_up{-0.125}.raw_value() == -13);
+static_assert(dec2_trunc{0.129}.raw_value() == 12);
+static_assert(dec2::from_raw(1234).raw_value() == 1234);
+
+static_assert(std::is_convertible_v<int, dec2>);
+static_assert(!std::is_convertible_v<double, dec2>);
+static_assert(!std::is_convertible_v<dec2, int>);
+static_assert(!std::is_convertible_v<dec4, dec2>);
+
+static_assert(static_cast<double>(dec2::from_raw(125)) == 1.25);
+static_assert(static_cast<int>(dec2::from_raw(250)) == 2);  // half-even
+static_assert(static_cast<int>(dec2::from_raw(350)) == 4);
+static_assert(static_cast<int>(dec2_up::from_raw(250)) == 3);
+
+static_assert(dec2{dec4::from_raw(12345)}.raw_value() == 123);  // 1.2345 -> 1.23
+static_assert(dec2{dec4::from_raw(12350)}.raw_value() == 124);  // 1.2350 -> 1.24 (half-even)
+static_assert(dec2{dec4::from_raw(12250)}.raw_value() == 122);  // 1.2250 -> 1.22 (half-even)
+static_assert(dec4{dec2::from_raw(123)}.raw_value() == 12300);
+
+// ============================================================================
+// Arithmetic
+// ============================================================================
+
+static_assert(dec2::from_raw(110) + dec2::from_raw(220) == dec2::from_raw(330));  // 1.1 + 2.2 == 3.3 exactly
+static_assert(dec2::from_raw(330) - dec2::from_raw(110) == dec2::from_raw(220));
+static_assert(-dec2::from_raw(5) == dec2::from_raw(-5));
+static_assert(dec2::from_raw(150) * dec2::from_raw(150) == dec2::from_raw(225));  // 1.5 * 1.5
+static_assert(dec2::from_raw(105) * dec2::from_raw(5) == dec2::from_raw(5));      // 0.0525 -> 0.05
+static_assert(dec2::from_raw(115) * dec2::from_raw(5) == dec2::from_raw(6));      // 0.0575 -> 0.06
+static_assert(dec2{1} / dec2{3} == dec2::from_raw(33));
+static_assert(dec2{2} / dec2{3} == dec2::from_raw(67));
+static_assert(dec2{-2} / dec2{3} == dec2::from_raw(-67));
+static_assert(dec2{2} / dec2{-3} == dec2::from_raw(-67));
+static_assert(dec2::from_raw(1295) * 137 == dec2::from_raw(177415));
+static_assert(137 * dec2::from_raw(1295) == dec2::from_raw(177415));
+static_assert(dec2{1} / 8 == dec2::from_raw(12));
+static_assert(dec2_up{1} / 8 == dec2_up::from_raw(13));
+
+static_assert([] {
+  dec2 d{10};
+  d += dec2{5};
+  d -= dec2{1};
+  d *= 3;
+  d /= 4;
+  return d;
+}() == dec2::from_raw(1050));
+
+// ============================================================================
+// Comparisons
+// ============================================================================
+
+static_assert(dec2{1} < dec2::from_raw(101));
+static_assert(dec2{1} == 1);
+static_assert(dec2::from_raw(150) > 1);
+static_assert(dec2::from_raw(150) < 2);
+static_assert(dec2{0} == 0);
+static_assert(dec2{1} != std::numeric_limits<std::uint64_t>::max());
+
+// ============================================================================
+// numeric_limits
+// ============================================================================
+
+static_assert(std::numeric_limits<dec2>::is_specialized);
+static_assert(!std::numeric_limits<dec2>::is_integer);
+static_assert(std::numeric_limits<dec2>::is_exact);
+static_assert(std::numeric_limits<dec2>::max().raw_value() == std::numeric_limits<std::int64_t>::max());
+static_assert(std::numeric_limits<dec2>::epsilon().raw_value() == 1);
+
+// ============================================================================
+// Quantities
+// ============================================================================
+
+using usd = quantity<currency[us_dollar], dec2>;
+using usc = quantity<currency[us_cent], dec2>;
+
+// integral scaling stays implicit, fractional scaling requires an explicit conversion
+static_assert(std::is_convertible_v<usd, usc>);
+static_assert(!std::is_convertible_v<usc, usd>);
+
+static_assert(usd{dec2::from_raw(1295) * us_dollar}.in(us_cent).numerical_value_in(us_cent) == dec2{1295});
+static_assert((dec2::from_raw(1295) * us_cent).force_in(us_dollar).numerical_value_in(us_dollar) ==
+              dec2::from_raw(13));  // 0.1295 -> 0.13
+static_assert((dec2::from_raw(125) * us_mill).force_in(us_cent).numerical_value_in(us_cent) ==
+              dec2::from_raw(12));  // 0.125 -> 0.12 (half-even)
+static_assert((dec2_up::from_raw(125) * us_mill).force_in(us_cent).numerical_value_in(us_cent) ==
+              dec2_up::from_raw(13));
+
+// exact decimal arithmetic on money quantities
+static_assert(dec2::from_raw(110) * us_dollar + dec2::from_raw(220) * us_dollar == dec2::from_raw(330) * us_dollar);
+static_assert(dec2{1} * us_dollar + dec2{5} * us_cent == dec2{105} * us_cent);
+static_assert((dec2::from_raw(1295) * us_dollar * 137).numerical_value_in(us_dollar) == dec2::from_raw(177415));
+static_assert(dec2{1} * us_dollar > dec2{99} * us_cent);
+
+// integral-rep quantities convert into decimal ones
+static_assert(usd{12 * us_dollar}.numerical_value_in(us_dollar) == 12);
+
+// other dimensions work too
+static_assert((dec4{1} * km).in(m).numerical_value_in(m) == 1000);
+static_assert((dec4{1234} * m).force_in(km).numerical_value_in(km) == dec4::from_raw(12340));
+
+}  // namespace
@@ -0,0 +1,125 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <mp-units/framework/customization_points.h>
+#include <mp-units/framework/quantity.h>
+#include <mp-units/framework/representation_concepts.h>
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+#include <mp-units/utility/dual.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <array>
+#include <type_traits>
+#endif
+
+namespace {
+
+using namespace mp_units;
+using namespace mp_units::utility;
+using namespace mp_units::si::unit_symbols;
+
+using d2 = dual<double, 2>;
+using d8 = dual<double, 8>;
+
+constexpr d2 x = d2::variable(3.0, 0);
+constexpr d2 y = d2::variable(4.0, 1);
+
+// ============================================================================
+// Representation concepts
+// ============================================================================
+
+static_assert(RepresentationOf<d2, quantity_tensor_order::scalar>);
+static_assert(RepresentationOf<d2, quantity_field::real>);
+static_assert(RepresentationOf<d8, isq::energy>);
+static_assert(treat_as_floating_point<d2>);
+static_assert(std::is_same_v<d2::value_type, double>);
+static_assert(sizeof(d8) == 9 * sizeof(double));
+static_assert(std::is_trivially_copyable_v<d8>);
+
+static_assert(std::is_convertible_v<double, d2>);
+static_assert(std::is_convertible_v<int, d2>);
+static_assert(!std::is_convertible_v<d2, double>);
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+static_assert(d2{}.value() == 0 && d2{}.tangents() == std::array{0.0, 0.0});
+static_assert(d2{5}.value() == 5 && d2{5}.tangents() == std::array{0.0, 0.0});
+static_assert(x.value() == 3 && x.tangents() == std::array{1.0, 0.0});
+static_assert(y.tangent(1) == 1);
+
+// ============================================================================
+// Arithmetic (chain rule)
+// ============================================================================
+
+static_assert((x + y).value() == 7 && (x + y).tangents() == std::array{1.0, 1.0});
+static_assert((x - y).value() == -1 && (x - y).tangents() == std::array{1.0, -1.0});
+static_assert((-x).tangents() == std::array{-1.0, 0.0});
+static_assert((x * y).value() == 12 && (x * y).tangents() == std::array{4.0, 3.0});
+static_assert((x / y).value() == 0.75 && (x / y).tangents() == std::array{0.25, -3.0 / 16});
+static_assert((x - x).tangents() == std::array{0.0, 0.0});
+static_assert((x * x * x).tangents() == std::array{27.0, 0.0});
+
+static_assert((x + 1).value() == 4 && (x + 1).tangents() == std::array{1.0, 0.0});
+static_assert((1 - x).value() == -2 && (1 - x).tangents() == std::array{-1.0, 0.0});
+static_assert((2 * x).tangents() == std::array{2.0, 0.0});
+static_assert((x * 2.5).tangents() == std::array{2.5, 0.0});
+static_assert((x / 2).tangents() == std::array{0.5, 0.0});
+static_assert((6 / x).value() == 2 && (6 / x).tangents() == std::array{-6.0 / 9, 0.0});
+
+static_assert([] {
+  d2 d = x;
+  d += y;
+  d *= x;
+  d -= 1;
+  d /= y;
+  return d;
+}() == (((x + y) * x) - 1) / y);
+
+static_assert(abs(-x).value() == 3 && abs(-x).tangents() == std::array{1.0, 0.0});
+
+// ============================================================================
+// Comparisons (value only)
+// ============================================================================
+
+static_assert(x < y);
+static_assert(x == d2{3});
+static_assert(x == 3);
+static_assert(x > 2.5);
+
+// ============================================================================
+// Quantities
+// ============================================================================
+
+// the tangents are scaled together with the value
+static_assert((x * km).in(m).numerical_value_in(m).tangents() == std::array{1000.0, 0.0});
+static_assert((x * m).force_in(km).numerical_value_in(km).value() == 0.003);
+
+// E = m v² / 2
+constexpr auto energy = isq::kinetic_energy(x * kg * (y * (m / s)) * (y * (m / s)) / 2);
+static_assert(energy.numerical_value_in(J).value() == 24);
+static_assert(energy.numerical_value_in(J).tangents() == std::array{8.0, 12.0});  // [v²/2, m v]
+
+}  // namespace
@@ -352,6 +352,15 @@ static_assert(get_value<double>(mag_ratio<1, -2>) == -0.5);
 static_assert(get_value<double>(mag_ratio<-1, -4>) == 0.25);
 static_assert(get_value<double>(mag_ratio<-1, -2>) == 0.5);
 
+// Magnitudes beyond 64 bits (e.g. the factors between the US survey and the customary units)
+static_assert(get_value<mp_units::detail::uint128_t>(mag_power<10, 21>) ==
+              mp_units::detail::uint128_t{1'000'000'000'000'000'000} * 1000);
+static_assert(get_value<mp_units::detail::int128_t>(mag_power<3937, 6>) ==
+              mp_units::detail::int128_t{3937LL * 3937 * 3937} * (3937LL * 3937 * 3937));
+static_assert(!try_get_value<std::uint64_t>(mag_power<10, 21>).has_value());
+static_assert(try_get_value<mp_units::detail::uint128_t>(mag_power<10, 21>).has_value());
+static_assert(!try_get_value<mp_units::detail::uint128_t>(mag_power<10, 39>).has_value());
+
 // ============================================================
 // numerator and denominator
 // ============================================================
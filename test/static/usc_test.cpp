@@ -21,11 +21,18 @@
 // SOFTWARE.
 
 #include <mp-units/bits/hacks.h>
+#include <mp-units/systems/astronomy.h>
+#include <mp-units/systems/imperial.h>
 #include <mp-units/systems/isq/mechanics.h>
 #include <mp-units/systems/isq/space_and_time.h>
 #include <mp-units/systems/si/prefixes.h>
 #include <mp-units/systems/si/units.h>
 #include <mp-units/systems/usc.h>
+#ifdef MP_UNITS_IMPORT_STD
+import std;
+#else
+#include <cstdint>
+#endif
 
 namespace {
 
@@ -124,6 +131,16 @@ static_assert(isq::mass(1 * lb_t) == isq::mass(12 * oz_t));
 // the next test is currently disabled; it surfaced #614
 // static_assert(isq::pressure(1'000 * inHg) == isq::pressure(3'386'389 * si::pascal));
 
+// Exact integer scaling with 128-bit factors
+// cubic US survey foot -> bushel: both the numerator and the denominator of the factor have 74 bits
+static_assert((mp_units::detail::int128_t{1'000'000} * cubic(survey1893::us_survey_foot))
+                .force_in(bu)
+                .numerical_value_in(bu) == 803'568);  // 803'568.99...
+// the denominator of the factor has 93 bits
+static_assert((std::int64_t{1'000'000'000'000'000'000} * (cubic(survey1893::us_survey_foot) / astronomy::light_year))
+                .force_in(imperial::gallon / si::metre)
+                .numerical_value_in(imperial::gallon / si::metre) == 658);  // 658.39...
+
 // Temperature
 static_assert(delta<isq::thermodynamic_temperature[deg_F]>(9) ==
               delta<isq::thermodynamic_temperature[si::degree_Celsius]>(5));